@@ -24,10 +24,13 @@
 #include <Background/backgroundcontroller.h>
 #include <Background/backgroundselectionmodel.h>
 #include <Wm/desktopwm.h>
+#include <statemanager.h>
+#include <powermanager.h>
 #include <X11/Xlib.h>
 #include <QScreen>
 #include <QMenu>
 #include <QFileDialog>
+#include "session/firstframecache.h"
 
 struct BackgroundPrivate {
     static BackgroundController* bg;
@@ -40,6 +43,7 @@ struct BackgroundPrivate {
     bool retrieving = false;
     bool retrieveAgain = false;
     BackgroundController::BackgroundData background;
+    QPixmap placeholder;
 
     bool isChangeBackgroundVisible = false;
     bool communityBackgroundSettingsShown = true;
@@ -111,6 +115,13 @@ Background::Background() :
 
     ui->showImageInformationBox->setChecked(d->bg->shouldShowCommunityLabels());
 
+    //Keep what's on screen so the next login can show it before the background is loaded
+    connect(StateManager::powerManager(), &PowerManager::powerOffOperationCommencing, this, [ = ](PowerManager::PowerOperation operation) {
+        if (operation != PowerManager::PowerOff && operation != PowerManager::Reboot && operation != PowerManager::LogOut) return;
+        if (d->retrieving || !d->oldScreen) return;
+        FirstFrameCache::instance()->saveSnapshot("background", d->oldScreen, d->background.px);
+    });
+
     ui->stackedWidget->setCurrentWidget(ui->backgroundPage);
     ui->stackedWidget->setCurrentAnimation(tStackedWidget::Fade);
     ui->backgroundPage->installEventFilter(this);
@@ -139,7 +150,7 @@ void Background::changeBackground() {
     }
 
     d->retrieving = true;
-    ui->stackedWidget->setCurrentWidget(ui->loadingBackgroundPage);
+    if (d->placeholder.isNull()) ui->stackedWidget->setCurrentWidget(ui->loadingBackgroundPage);
 
     d->bg->getCurrentBackground(this->size())->then([ = ](BackgroundController::BackgroundData data) {
         d->background = data;
@@ -211,11 +222,13 @@ void Background::changeBackground() {
                 d->retrieveAgain = false;
                 this->changeBackground();
             } else {
+                d->placeholder = QPixmap();
                 ui->stackedWidget->setCurrentWidget(ui->backgroundPage);
             }
         });
     })->error([ = ](QString error) {
         d->retrieving = false;
+        d->placeholder = QPixmap();
         if (d->retrieveAgain) {
             d->retrieveAgain = false;
             this->changeBackground();
@@ -276,7 +289,9 @@ bool Background::eventFilter(QObject* watched, QEvent* event) {
     if (watched == ui->backgroundPage) {
         if (event->type() == QEvent::Paint) {
             QPainter p(ui->backgroundPage);
-            if (d->retrieving) {
+            if (d->retrieving && !d->placeholder.isNull()) {
+                p.drawPixmap(0, -ui->backgroundSelectionWidget->height(), this->width(), this->height(), d->placeholder);
+            } else if (d->retrieving) {
                 p.setPen(Qt::transparent);
                 p.setBrush(Qt::black);
                 p.drawRect(0, 0, this->width(), this->height());
@@ -314,8 +329,16 @@ void Background::resizeToScreen(int screen) {
         connect(s, &QScreen::geometryChanged, this, [ = ] {
             this->setGeometry(s->geometry());
         });
+
+        //Carry on showing the last session's background until the real one has loaded
+        if (!d->oldScreen) {
+            d->placeholder = FirstFrameCache::instance()->snapshot("background", s);
+            if (!d->placeholder.isNull()) ui->stackedWidget->setCurrentWidget(ui->backgroundPage, false);
+        }
+
         this->setGeometry(s->geometry());
         this->show();
+        FirstFrameCache::instance()->dismissPlaceholder("background", s);
 
         d->oldScreen = s;
     }
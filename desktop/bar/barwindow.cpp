@@ -22,18 +22,22 @@
 
 #include <QScreen>
 #include <QPainter>
-#include <QGraphicsOpacityEffect>
+#include <QApplication>
 #include <Wm/desktopwm.h>
 
 #include "mainbarwidget.h"
 #include "statuscenter/statuscenter.h"
 #include <tvariantanimation.h>
 
-#include <tsettings.h>
+#include <settingbinding.h>
 
 #include <statemanager.h>
 #include <statuscentermanager.h>
 #include <barmanager.h>
+#include <windowstatemanager.h>
+#include <animationclock.h>
+#include <powermanager.h>
+#include "session/firstframecache.h"
 
 #include <keygrab.h>
 
@@ -44,17 +48,21 @@ struct BarWindowPrivate {
     tVariantAnimation* heightAnim;
     tVariantAnimation* barStatusCenterTransitionAnim;
 
-    QGraphicsOpacityEffect* mainBarOpacity;
-    QGraphicsOpacityEffect* statusCenterOpacity;
+    //Snapshots painted in place of the live widgets while the Status Center transition runs
+    QPixmap mainBarSnapshot;
+    QPixmap statusCenterSnapshot;
+    bool showingSnapshots = false;
+    double transitionPercentage = 0;
 
     QScreen* oldPrimaryScreen = nullptr;
 
-    QList<DesktopWmWindowPtr> maximisedWindows;
-
     bool expanding = true;
     bool statusCenterShown = false;
 
-    tSettings settings;
+    //The height the window will have once scheduled frame work is flushed
+    int barHeight = 0;
+
+    SettingBinding<bool>* translucent;
 };
 
 BarWindow::BarWindow(QWidget* parent) :
@@ -63,6 +71,7 @@ BarWindow::BarWindow(QWidget* parent) :
 
     ui->setupUi(this);
     d = new BarWindowPrivate();
+    d->barHeight = this->height();
 
     this->setAttribute(Qt::WA_TranslucentBackground);
 
@@ -72,21 +81,15 @@ BarWindow::BarWindow(QWidget* parent) :
 
     d->statusCenterWidget = new StatusCenter(this);
 
-    d->mainBarOpacity = new QGraphicsOpacityEffect(d->mainBarWidget);
-    d->mainBarOpacity->setEnabled(false);
-    d->mainBarWidget->setGraphicsEffect(d->mainBarOpacity);
-
-    d->statusCenterOpacity = new QGraphicsOpacityEffect(d->statusCenterWidget);
-    d->statusCenterOpacity->setEnabled(false);
-    d->statusCenterWidget->setGraphicsEffect(d->statusCenterOpacity);
     d->statusCenterWidget->setVisible(false);
 
     d->heightAnim = new tVariantAnimation(this);
     d->heightAnim->setDuration(500);
     d->heightAnim->setEasingCurve(QEasingCurve::OutCubic);
     connect(d->heightAnim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        this->setFixedHeight(value.toInt() + 1);
+        setBarHeight(value.toInt() + 1);
     });
+    StateManager::animationClock()->registerAnimation(d->heightAnim);
 
     d->barStatusCenterTransitionAnim = new tVariantAnimation();
     d->barStatusCenterTransitionAnim->setStartValue(0.0);
@@ -96,37 +99,27 @@ BarWindow::BarWindow(QWidget* parent) :
     connect(d->barStatusCenterTransitionAnim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
         double percentage = value.toDouble();
         if (qFuzzyIsNull(percentage)) { //Fully show bar view
+            setShowingSnapshots(false);
             d->statusCenterWidget->setVisible(false);
             d->mainBarWidget->setVisible(true);
-            d->statusCenterOpacity->setEnabled(false);
-            d->mainBarOpacity->setEnabled(false);
-            this->setFixedHeight(d->mainBarWidget->expandedHeight());
+            setBarHeight(d->mainBarWidget->expandedHeight());
             ui->line->setVisible(true);
         } else if (qFuzzyCompare(percentage, 1)) { //Fully show Status Center view
+            setShowingSnapshots(false);
             d->statusCenterWidget->setVisible(true);
             d->mainBarWidget->setVisible(false);
-            d->statusCenterOpacity->setEnabled(false);
-            d->mainBarOpacity->setEnabled(false);
-            this->setFixedHeight(d->statusCenterWidget->height());
+            setBarHeight(d->statusCenterWidget->height());
             ui->line->setVisible(false);
         } else {
-            if (percentage < 0.5) { //Animate the bar
-                d->mainBarOpacity->setOpacity(1 - (percentage * 2));
-                d->mainBarOpacity->setEnabled(true);
-                d->mainBarWidget->setVisible(true);
-                d->statusCenterWidget->setVisible(false);
-                d->statusCenterOpacity->setEnabled(false);
-            } else { //Animate the Status Center
-                d->statusCenterOpacity->setOpacity(percentage * 2 - 1);
-                d->statusCenterOpacity->setEnabled(true);
-                d->statusCenterWidget->setVisible(true);
-                d->mainBarWidget->setVisible(false);
-                d->mainBarOpacity->setEnabled(false);
-            }
-            this->setFixedHeight((d->statusCenterWidget->height() - d->mainBarWidget->expandedHeight()) * percentage + d->mainBarWidget->expandedHeight());
+            //Paint the snapshots instead of rendering both widget trees every frame
+            setShowingSnapshots(true);
+            d->transitionPercentage = percentage;
+            setBarHeight((d->statusCenterWidget->height() - d->mainBarWidget->expandedHeight()) * percentage + d->mainBarWidget->expandedHeight());
             ui->line->setVisible(true);
+            this->update();
         }
     });
+    StateManager::animationClock()->registerAnimation(d->barStatusCenterTransitionAnim);
 
     //Tell the window manager that this is a "taskbar" type window
     this->setWindowFlag(Qt::FramelessWindowHint);
@@ -147,21 +140,16 @@ BarWindow::BarWindow(QWidget* parent) :
         }
     });
 
-    connect(&d->settings, &tSettings::settingChanged, this, [ = ](QString key, QVariant value) {
-        if (key == "Appearance/translucent") {
-            this->update();
-        }
+    d->translucent = new SettingBinding<bool>("Appearance/translucent", this);
+    connect(d->translucent, &SettingBindingBase::changed, this, QOverload<>::of(&BarWindow::update));
+    connect(StateManager::windowStateManager(), &WindowStateManager::maximisedWindowsChanged, this, [ = ](QScreen* screen) {
+        if (screen == qApp->primaryScreen()) this->update();
     });
-    connect(DesktopWm::instance(), &DesktopWm::windowAdded, this, &BarWindow::trackWindow);
-    connect(DesktopWm::instance(), &DesktopWm::windowRemoved, this, [ = ](DesktopWmWindowPtr window) {
-        if (d->maximisedWindows.contains(window)) {
-            d->maximisedWindows.removeAll(window);
-            this->update();
-        }
+
+    connect(StateManager::powerManager(), &PowerManager::powerOffOperationCommencing, this, [ = ](PowerManager::PowerOperation operation) {
+        if (operation != PowerManager::PowerOff && operation != PowerManager::Reboot && operation != PowerManager::LogOut) return;
+        FirstFrameCache::instance()->saveSnapshot("bar", qApp->primaryScreen(), renderCollapsed());
     });
-    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
-        trackWindow(window);
-    }
 
     KeyGrab* statusCenterGrab = new KeyGrab(QKeySequence(Qt::MetaModifier | Qt::Key_Tab));
     connect(statusCenterGrab, &KeyGrab::activated, this, [ = ] {
@@ -195,32 +183,21 @@ void BarWindow::leaveEvent(QEvent* event) {
 
 void BarWindow::paintEvent(QPaintEvent* event) {
     QColor bgCol = this->palette().color(QPalette::Window);
-    if (d->settings.value("Appearance/translucent").toBool() && d->maximisedWindows.count() == 0) bgCol.setAlpha(150);
+    if (d->translucent->value() && !StateManager::windowStateManager()->hasMaximisedWindow(qApp->primaryScreen())) bgCol.setAlpha(150);
 
     QPainter painter(this);
     painter.setPen(Qt::transparent);
     painter.setBrush(bgCol);
     painter.drawRect(0, 0, this->width(), this->height());
-}
-
-void BarWindow::trackWindow(DesktopWmWindowPtr window) {
-    window->disconnect(this);
-    connect(window, &DesktopWmWindow::geometryChanged, this, [ = ] {
-        trackWindow(window);
-    });
-    connect(window, &DesktopWmWindow::windowStateChanged, this, [ = ] {
-        trackWindow(window);
-    });
 
-    QRect screenGeometry = QApplication::primaryScreen()->geometry();
-    if (window->isMaximised() && !window->isMinimized() && screenGeometry.contains(window->geometry())) {
-        if (d->maximisedWindows.contains(window)) return;
-        d->maximisedWindows.append(window);
-        this->update();
-    } else if (!window->isMaximised() || window->isMinimized()) {
-        if (!d->maximisedWindows.contains(window)) return;
-        d->maximisedWindows.removeAll(window);
-        this->update();
+    if (d->showingSnapshots) {
+        if (d->transitionPercentage < 0.5) {
+            painter.setOpacity(1 - (d->transitionPercentage * 2));
+            painter.drawPixmap(d->mainBarWidget->pos(), d->mainBarSnapshot);
+        } else {
+            painter.setOpacity(d->transitionPercentage * 2 - 1);
+            painter.drawPixmap(d->statusCenterWidget->pos(), d->statusCenterSnapshot);
+        }
     }
 }
 
@@ -239,10 +216,8 @@ void BarWindow::updatePrimaryScreen() {
     this->move(primaryScreen->geometry().topLeft());
     d->statusCenterWidget->setFixedHeight(primaryScreen->geometry().height());
 
-    //Refresh the state of all the windows
-    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
-        trackWindow(window);
-    }
+    //The primary screen may have changed, so the bar may need to change translucency
+    this->update();
 
     barHeightChanged();
 }
@@ -253,7 +228,7 @@ void BarWindow::barHeightChanged() {
 
     if (!d->statusCenterShown) {
         QSignalBlocker blocker(d->heightAnim);
-        d->heightAnim->setStartValue(this->height() - 1);
+        d->heightAnim->setStartValue(d->barHeight - 1);
         d->heightAnim->setEndValue(d->expanding ? d->mainBarWidget->expandedHeight() : d->mainBarWidget->statusBarHeight());
 
         d->heightAnim->stop();
@@ -261,10 +236,66 @@ void BarWindow::barHeightChanged() {
     }
 }
 
+void BarWindow::setBarHeight(int height) {
+    //Both bar animations resize the window, so only apply the latest height once per frame
+    d->barHeight = height;
+    StateManager::animationClock()->scheduleFrameWork(this, "height", [ = ] {
+        this->setFixedHeight(height);
+    });
+}
+
+QPixmap BarWindow::renderCollapsed() {
+    //Lay the bar out at its collapsed height just for this render, whatever state it is in now
+    int collapsedHeight = d->mainBarWidget->statusBarHeight();
+    d->mainBarWidget->barHeightChanged(collapsedHeight);
+    QApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+
+    QColor bgCol = this->palette().color(QPalette::Window);
+    if (d->translucent->value() && !StateManager::windowStateManager()->hasMaximisedWindow(qApp->primaryScreen())) bgCol.setAlpha(150);
+
+    QPixmap snapshot(QSize(this->width(), collapsedHeight + 1) * this->devicePixelRatioF());
+    snapshot.setDevicePixelRatio(this->devicePixelRatioF());
+    snapshot.fill(Qt::transparent);
+
+    QPainter painter(&snapshot);
+    painter.setPen(Qt::transparent);
+    painter.setBrush(bgCol);
+    painter.drawRect(0, 0, this->width(), collapsedHeight + 1);
+    d->mainBarWidget->render(&painter, QPoint(0, 0), QRegion(0, 0, this->width(), collapsedHeight), QWidget::DrawChildren);
+    ui->line->render(&painter, QPoint(0, collapsedHeight));
+    painter.end();
+
+    d->mainBarWidget->barHeightChanged(d->barHeight - 1);
+    QApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+    return snapshot;
+}
+
+void BarWindow::takeTransitionSnapshots() {
+    //Grab the widgets once so each transition frame is a single blit
+    d->mainBarSnapshot = d->mainBarWidget->grab();
+    d->statusCenterSnapshot = d->statusCenterWidget->grab();
+}
+
+void BarWindow::setShowingSnapshots(bool showingSnapshots) {
+    if (d->showingSnapshots == showingSnapshots) return;
+    d->showingSnapshots = showingSnapshots;
+
+    if (showingSnapshots) {
+        d->mainBarWidget->setVisible(false);
+        d->statusCenterWidget->setVisible(false);
+    } else {
+        d->mainBarSnapshot = QPixmap();
+        d->statusCenterSnapshot = QPixmap();
+    }
+    this->update();
+}
+
 void BarWindow::showStatusCenter() {
     QSignalBlocker blocker(d->heightAnim);
     d->heightAnim->stop();
 
+    if (!d->showingSnapshots) takeTransitionSnapshots();
+
     StateManager::statusCenterManager()->setIsShowingStatusCenter(true);
     d->barStatusCenterTransitionAnim->setDirection(tVariantAnimation::Forward);
     d->barStatusCenterTransitionAnim->start();
@@ -276,6 +307,8 @@ void BarWindow::showStatusCenter() {
 }
 
 void BarWindow::hideStatusCenter() {
+    if (!d->showingSnapshots) takeTransitionSnapshots();
+
     StateManager::statusCenterManager()->setIsShowingStatusCenter(false);
     d->barStatusCenterTransitionAnim->setDirection(tVariantAnimation::Backward);
     d->barStatusCenterTransitionAnim->start();
@@ -290,7 +323,7 @@ void BarWindow::showBar() {
     //If we're showing the status bar, don't touch the height
     if (!StateManager::statusCenterManager()->isShowingStatusCenter()) {
         QSignalBlocker blocker(d->heightAnim);
-        d->heightAnim->setStartValue(this->height() - 1);
+        d->heightAnim->setStartValue(d->barHeight - 1);
         d->heightAnim->setEndValue(d->mainBarWidget->expandedHeight());
 
         d->heightAnim->stop();
@@ -302,7 +335,7 @@ void BarWindow::hideBar() {
     //If we're showing the status bar, don't touch the height
     if (!StateManager::statusCenterManager()->isShowingStatusCenter() && !StateManager::barManager()->isBarLocked()) {
         QSignalBlocker blocker(d->heightAnim);
-        d->heightAnim->setStartValue(this->height() - 1);
+        d->heightAnim->setStartValue(d->barHeight - 1);
         d->heightAnim->setEndValue(d->mainBarWidget->statusBarHeight());
 
         d->heightAnim->stop();
@@ -44,10 +44,14 @@ class BarWindow : public QWidget {
         void leaveEvent(QEvent* event);
         void paintEvent(QPaintEvent* event);
 
-        void trackWindow(DesktopWmWindowPtr window);
 
         void updatePrimaryScreen();
         void barHeightChanged();
+        void setBarHeight(int height);
+
+        QPixmap renderCollapsed();
+        void takeTransitionSnapshots();
+        void setShowingSnapshots(bool showingSnapshots);
 
         void showStatusCenter();
         void hideStatusCenter();
@@ -23,8 +23,7 @@
 #include <statemanager.h>
 #include <barmanager.h>
 #include <chunk.h>
-#include <QFrame>
-#include <QGraphicsOpacityEffect>
+#include <QPainter>
 #include "common/common.h"
 
 struct ChunkContainerPrivate {
@@ -44,6 +43,10 @@ struct ChunkContainerPrivate {
     };
 
     QMap<Chunk*, QWidget*> chunkWidgets;
+
+    //Separators are painted by the container so they can fade without an opacity effect
+    QMap<Chunk*, QWidget*> separators;
+    qreal separatorOpacity = 1;
 };
 
 ChunkContainer::ChunkContainer(QWidget* parent) :
@@ -62,6 +65,9 @@ ChunkContainer::ChunkContainer(QWidget* parent) :
     connect(StateManager::barManager(), &BarManager::barHeightTransitioning, this, [ = ](qreal percentage) {
         int spacing = 3 + 3 * percentage;
         ui->chunkLayout->setSpacing(spacing);
+
+        d->separatorOpacity = percentage;
+        this->update();
     });
 }
 
@@ -99,15 +105,22 @@ void ChunkContainer::barHeightChanged(int height) {
 }
 
 void ChunkContainer::paintEvent(QPaintEvent* event) {
-
+    QPainter painter(this);
+    painter.setOpacity(d->separatorOpacity);
+    painter.setPen(this->palette().color(QPalette::WindowText));
+    for (QWidget* separator : d->separators.values()) {
+        if (!separator->isVisible()) continue;
+
+        QRect geometry(separator->mapTo(this, QPoint(0, 0)), separator->size());
+        painter.drawLine(geometry.topLeft(), geometry.bottomLeft());
+    }
 }
 
 void ChunkContainer::chunkAdded(Chunk* chunk) {
     //Create a chunk widget
     QWidget* chunkWidget = new QWidget();
     QBoxLayout* chunkWidgetLayout = new QBoxLayout(QBoxLayout::LeftToRight, chunkWidget);
-    QFrame* line = new QFrame(chunkWidget);
-    line->setFrameShape(QFrame::VLine);
+    QWidget* line = new QWidget(chunkWidget);
     line->setFixedWidth(1);
     chunkWidgetLayout->addWidget(line);
     chunkWidgetLayout->addWidget(chunk);
@@ -115,10 +128,7 @@ void ChunkContainer::chunkAdded(Chunk* chunk) {
     chunkWidgetLayout->setContentsMargins(0, 0, 0, 0);
     chunkWidget->setLayout(chunkWidgetLayout);
     d->chunkWidgets.insert(chunk, chunkWidget);
-
-    QGraphicsOpacityEffect* lineOpacity = new QGraphicsOpacityEffect(line);
-    lineOpacity->setOpacity(1);
-    line->setGraphicsEffect(lineOpacity);
+    d->separators.insert(chunk, line);
 
     QStringList currentItems;
     for (QPair<QString, Chunk*> item : d->loadedChunks) {
@@ -141,11 +151,11 @@ void ChunkContainer::chunkAdded(Chunk* chunk) {
             QPair<QString, Chunk*> chunkDescriptor = d->loadedChunks.at(i);
             if (chunkDescriptor.second == chunk) {
                 line->setVisible(i != 0);
+                this->update();
                 return;
             }
         }
     });
-    connect(StateManager::barManager(), &BarManager::barHeightTransitioning, lineOpacity, &QGraphicsOpacityEffect::setOpacity);
 
     emit statusBarHeightChanged();
     emit expandedHeightChanged();
@@ -157,6 +167,7 @@ void ChunkContainer::chunkRemoved(Chunk* chunk) {
     for (int i = 0; i < d->loadedChunks.count(); i++) {
         if (d->loadedChunks.at(i).second == chunk) {
             QWidget* chunkWidget = d->chunkWidgets.take(chunk);
+            d->separators.remove(chunk);
             ui->chunkLayout->removeWidget(chunkWidget);
             d->loadedChunks.removeAt(i);
             chunk->setParent(nullptr);
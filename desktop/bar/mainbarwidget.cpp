@@ -27,6 +27,7 @@
 #include <QDebug>
 #include <statemanager.h>
 #include <hudmanager.h>
+#include <idleworkqueue.h>
 
 #include <Screens/screendaemon.h>
 #include <Screens/systemscreen.h>
@@ -43,6 +44,11 @@ MainBarWidget::MainBarWidget(QWidget* parent) :
     connect(new KeyGrab(QKeySequence(Qt::Key_Super_L), "gatewayOpen"), &KeyGrab::activated, this, [ = ] {
         Gateway::instance()->show();
     });
+
+    //Build the Gateway ahead of time so that it opens instantly
+    StateManager::idleWorkQueue()->enqueue(this, [ = ] {
+        Gateway::instance();
+    }, IdleWorkQueue::Low, 30000);
 }
 
 MainBarWidget::~MainBarWidget() {
@@ -0,0 +1,79 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "taskbardelegate.h"
+
+#include <QPainter>
+#include <the-libs_global.h>
+#include "taskbarmodel.h"
+
+TaskbarDelegate::TaskbarDelegate(QWidget* parent) : QStyledItemDelegate(parent) {
+
+}
+
+void TaskbarDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    painter->save();
+    painter->setFont(option.font);
+    painter->setLayoutDirection(option.direction);
+
+    QRect iconRect;
+    iconRect.setLeft(option.rect.left() + SC_DPI(6));
+    iconRect.setTop(option.rect.top() + (option.rect.height() - SC_DPI(32)) / 2);
+    iconRect.setWidth(SC_DPI(32));
+    iconRect.setHeight(SC_DPI(32));
+
+    QRect textRect;
+    textRect.setLeft(iconRect.right() + SC_DPI(6));
+    textRect.setTop(option.rect.top());
+    textRect.setBottom(option.rect.bottom());
+    textRect.setRight(option.rect.right() - SC_DPI(6));
+
+    if (option.direction == Qt::RightToLeft) {
+        iconRect.moveRight(option.rect.right() - SC_DPI(6));
+        textRect.moveRight(iconRect.left() - SC_DPI(6));
+    }
+
+    bool active = index.data(TaskbarModel::ActiveRole).toBool();
+    if (active || option.state & QStyle::State_MouseOver) {
+        QColor col = option.palette.color(QPalette::Highlight);
+        if (!active) col.setAlpha(127);
+        painter->setPen(Qt::transparent);
+        painter->setBrush(col);
+        painter->drawRect(option.rect);
+    }
+
+    QString text = index.data().toString();
+    int windowCount = index.data(TaskbarModel::WindowCountRole).toInt();
+    if (windowCount > 1) text = QStringLiteral("%1 (%2)").arg(text, QLocale().toString(windowCount));
+
+    painter->setBrush(Qt::transparent);
+    painter->setPen(option.palette.color(active ? QPalette::HighlightedText : QPalette::WindowText));
+    painter->drawText(textRect, Qt::AlignLeading | Qt::AlignVCenter, option.fontMetrics.elidedText(text, Qt::ElideRight, textRect.width()));
+    painter->drawPixmap(iconRect, index.data(Qt::DecorationRole).value<QIcon>().pixmap(SC_DPI_T(QSize(32, 32), QSize)));
+    painter->restore();
+}
+
+QSize TaskbarDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    QString text = index.data().toString();
+    int windowCount = index.data(TaskbarModel::WindowCountRole).toInt();
+    if (windowCount > 1) text = QStringLiteral("%1 (%2)").arg(text, QLocale().toString(windowCount));
+
+    int width = SC_DPI(6) + SC_DPI(32) + SC_DPI(6) + qMin(option.fontMetrics.horizontalAdvance(text), SC_DPI(200)) + SC_DPI(6);
+    return QSize(width, SC_DPI(44));
+}
@@ -0,0 +1,261 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "taskbarmodel.h"
+
+#include <QIcon>
+#include <Wm/desktopwm.h>
+#include <Applications/application.h>
+#include <performancemonitor.h>
+
+struct TaskbarEntry {
+    QString key;
+    QList<DesktopWmWindowPtr> windows;
+};
+
+struct TaskbarModelPrivate {
+    QList<TaskbarEntry*> entries;
+    QHash<QString, TaskbarEntry*> entriesByKey;
+    QHash<QString, int> rows;
+    QHash<DesktopWmWindow*, QString> windowKeys;
+
+    //Resolving theme icons is expensive, so keep them around for as long as a window using them is open
+    mutable QHash<QString, QIcon> iconCache;
+
+    QString activeKey;
+    bool grouped = false;
+};
+
+TaskbarModel::TaskbarModel(QObject* parent)
+    : QAbstractListModel(parent) {
+    d = new TaskbarModelPrivate();
+
+    connect(DesktopWm::instance(), &DesktopWm::windowAdded, this, &TaskbarModel::addWindow);
+    connect(DesktopWm::instance(), &DesktopWm::windowRemoved, this, &TaskbarModel::removeWindow);
+    connect(DesktopWm::instance(), &DesktopWm::activeWindowChanged, this, &TaskbarModel::activeWindowChanged);
+
+    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
+        this->addWindow(window);
+    }
+    activeWindowChanged();
+}
+
+TaskbarModel::~TaskbarModel() {
+    qDeleteAll(d->entries);
+    delete d;
+}
+
+void TaskbarModel::setGrouped(bool grouped) {
+    if (d->grouped == grouped) return;
+
+    beginResetModel();
+    d->grouped = grouped;
+
+    QList<DesktopWmWindowPtr> windows;
+    for (TaskbarEntry* entry : qAsConst(d->entries)) {
+        windows.append(entry->windows);
+    }
+    qDeleteAll(d->entries);
+    d->entries.clear();
+    d->entriesByKey.clear();
+    d->rows.clear();
+    d->windowKeys.clear();
+
+    for (DesktopWmWindowPtr window : qAsConst(windows)) {
+        if (!window) continue;
+        QString key = keyForWindow(window);
+        TaskbarEntry* entry = d->entriesByKey.value(key);
+        if (!entry) {
+            entry = new TaskbarEntry();
+            entry->key = key;
+            d->rows.insert(key, d->entries.count());
+            d->entries.append(entry);
+            d->entriesByKey.insert(key, entry);
+        }
+        entry->windows.append(window);
+        d->windowKeys.insert(window, key);
+    }
+    d->activeKey = d->windowKeys.value(DesktopWm::activeWindow());
+    endResetModel();
+}
+
+bool TaskbarModel::isGrouped() {
+    return d->grouped;
+}
+
+QList<DesktopWmWindowPtr> TaskbarModel::windows(const QModelIndex& index) {
+    if (!index.isValid()) return {};
+    return d->entries.at(index.row())->windows;
+}
+
+int TaskbarModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+
+    return d->entries.count();
+}
+
+QVariant TaskbarModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) return QVariant();
+
+    TaskbarEntry* entry = d->entries.at(index.row());
+    DesktopWmWindowPtr window = entry->windows.isEmpty() ? nullptr : entry->windows.first();
+    if (!window) return QVariant();
+
+    ApplicationPointer app = window->application();
+    switch (role) {
+        case Qt::DisplayRole:
+            if (app) return app->getProperty("Name").toString();
+            return window->title();
+        case Qt::DecorationRole: {
+            if (!app) return window->icon();
+
+            QString iconName = app->getProperty("Icon").toString();
+            bool cached = d->iconCache.contains(iconName);
+            PerformanceMonitor::recordCacheLookup("taskbar-icons", cached);
+            if (!cached) d->iconCache.insert(iconName, QIcon::fromTheme(iconName));
+            return d->iconCache.value(iconName);
+        }
+        case ActiveRole:
+            return entry->key == d->activeKey;
+        case WindowCountRole:
+            return entry->windows.count();
+    }
+
+    return QVariant();
+}
+
+void TaskbarModel::addWindow(DesktopWmWindowPtr window) {
+    if (!window->shouldShowInTaskbar()) return;
+    if (d->windowKeys.contains(window)) return;
+
+    connect(window, &DesktopWmWindow::titleChanged, this, [ = ] {
+        updateWindow(window);
+    });
+    connect(window, &DesktopWmWindow::iconChanged, this, [ = ] {
+        updateWindow(window);
+    });
+    connect(window, &DesktopWmWindow::applicationChanged, this, [ = ] {
+        if (keyForWindow(window) == d->windowKeys.value(window)) {
+            //Still the same entry, but the name and icon may have changed
+            updateWindow(window);
+        } else {
+            //The window needs to move into a different group
+            removeWindow(window);
+            addWindow(window);
+        }
+    });
+
+    QString key = keyForWindow(window);
+    d->windowKeys.insert(window, key);
+
+    TaskbarEntry* entry = d->entriesByKey.value(key);
+    if (entry) {
+        entry->windows.append(window);
+        emitChanged(key);
+    } else {
+        entry = new TaskbarEntry();
+        entry->key = key;
+        entry->windows.append(window);
+
+        int row = d->entries.count();
+        beginInsertRows(QModelIndex(), row, row);
+        d->entries.append(entry);
+        d->entriesByKey.insert(key, entry);
+        d->rows.insert(key, row);
+        endInsertRows();
+    }
+}
+
+void TaskbarModel::removeWindow(DesktopWmWindowPtr window) {
+    if (!d->windowKeys.contains(window)) return;
+    window->disconnect(this);
+
+    QString key = d->windowKeys.take(window);
+    TaskbarEntry* entry = d->entriesByKey.value(key);
+    if (!entry) return;
+
+    entry->windows.removeAll(window);
+    if (entry->windows.isEmpty()) {
+        int row = d->rows.value(key);
+        beginRemoveRows(QModelIndex(), row, row);
+        d->entries.removeAt(row);
+        d->entriesByKey.remove(key);
+        d->rows.remove(key);
+        reindexFrom(row);
+        endRemoveRows();
+        delete entry;
+
+        releaseIcon(window);
+    } else {
+        emitChanged(key);
+    }
+}
+
+void TaskbarModel::updateWindow(DesktopWmWindowPtr window) {
+    emitChanged(d->windowKeys.value(window));
+}
+
+void TaskbarModel::activeWindowChanged() {
+    //Only touch the entries that gained or lost focus
+    QString oldKey = d->activeKey;
+    d->activeKey = d->windowKeys.value(DesktopWm::activeWindow());
+    if (oldKey == d->activeKey) return;
+
+    emitChanged(oldKey);
+    emitChanged(d->activeKey);
+}
+
+void TaskbarModel::emitChanged(QString key) {
+    if (!d->rows.contains(key)) return;
+
+    QModelIndex idx = index(d->rows.value(key));
+    emit dataChanged(idx, idx);
+}
+
+QString TaskbarModel::keyForWindow(DesktopWmWindowPtr window) {
+    if (d->grouped) {
+        ApplicationPointer app = window->application();
+        if (app) return QStringLiteral("app:") + app->desktopEntry();
+    }
+    return QStringLiteral("window:") + QString::number(reinterpret_cast<quintptr>(window.data()));
+}
+
+void TaskbarModel::releaseIcon(DesktopWmWindowPtr window) {
+    ApplicationPointer app = window->application();
+    if (!app) return;
+
+    QString iconName = app->getProperty("Icon").toString();
+    if (!d->iconCache.contains(iconName)) return;
+
+    //Keep the icon if another entry still shows it
+    for (TaskbarEntry* entry : qAsConst(d->entries)) {
+        for (DesktopWmWindowPtr other : qAsConst(entry->windows)) {
+            if (!other) continue;
+            ApplicationPointer otherApp = other->application();
+            if (otherApp && otherApp->getProperty("Icon").toString() == iconName) return;
+        }
+    }
+    d->iconCache.remove(iconName);
+}
+
+void TaskbarModel::reindexFrom(int row) {
+    for (int i = row; i < d->entries.count(); i++) {
+        d->rows.insert(d->entries.at(i)->key, i);
+    }
+}
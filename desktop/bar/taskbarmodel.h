@@ -0,0 +1,64 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef TASKBARMODEL_H
+#define TASKBARMODEL_H
+
+#include <QAbstractListModel>
+#include <QPointer>
+
+class DesktopWmWindow;
+typedef QPointer<DesktopWmWindow> DesktopWmWindowPtr;
+
+struct TaskbarModelPrivate;
+class TaskbarModel : public QAbstractListModel {
+        Q_OBJECT
+
+    public:
+        explicit TaskbarModel(QObject* parent = nullptr);
+        ~TaskbarModel() override;
+
+        enum Roles {
+            ActiveRole = Qt::UserRole,
+            WindowCountRole
+        };
+
+        void setGrouped(bool grouped);
+        bool isGrouped();
+
+        QList<DesktopWmWindowPtr> windows(const QModelIndex& index);
+
+        // Basic functionality:
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    private:
+        TaskbarModelPrivate* d;
+
+        void addWindow(DesktopWmWindowPtr window);
+        void removeWindow(DesktopWmWindowPtr window);
+        void updateWindow(DesktopWmWindowPtr window);
+        void activeWindowChanged();
+        void emitChanged(QString key);
+        QString keyForWindow(DesktopWmWindowPtr window);
+        void releaseIcon(DesktopWmWindowPtr window);
+        void reindexFrom(int row);
+};
+
+#endif // TASKBARMODEL_H
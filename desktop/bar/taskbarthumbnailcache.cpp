@@ -0,0 +1,363 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "taskbarthumbnailcache.h"
+
+#include <QCache>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QApplication>
+#include <QVector>
+#include <climits>
+#include <cstdlib>
+#include <the-libs_global.h>
+#include <Wm/desktopwm.h>
+#include <performancemonitor.h>
+
+#ifdef HAVE_XCOMPOSITE
+    #include <QX11Info>
+    #include <xcb/xcb.h>
+    #include <xcb/damage.h>
+    #include <X11/Xlib.h>
+    #include <X11/Xutil.h>
+    #include <X11/extensions/Xcomposite.h>
+    #include <X11/extensions/Xdamage.h>
+    #include <X11/extensions/Xrender.h>
+#endif
+
+//Don't capture a window more often than this, no matter how often it is damaged
+#define THUMBNAIL_THROTTLE 500
+
+struct TaskbarThumbnailWindow {
+    unsigned long xWindow = 0;
+    unsigned long damage = 0;
+    bool dirty = true;
+    bool refreshPending = false;
+    QElapsedTimer lastCapture;
+};
+
+struct TaskbarThumbnailCachePrivate {
+    bool available = false;
+    int damageEventBase = 0;
+
+    QHash<DesktopWmWindow*, TaskbarThumbnailWindow> windows;
+    QHash<unsigned long, DesktopWmWindow*> windowsByDamage;
+
+    //X windows learnt from _NET_ACTIVE_WINDOW, which identify the client exactly
+    QHash<DesktopWmWindow*, unsigned long> activatedXWindows;
+    unsigned long activeWindowAtom = 0;
+
+    //Cost is the size of the thumbnail in bytes
+    QCache<DesktopWmWindow*, QPixmap> thumbnails;
+};
+
+TaskbarThumbnailCache::TaskbarThumbnailCache(QObject* parent) : QObject(parent) {
+    d = new TaskbarThumbnailCachePrivate();
+    d->thumbnails.setMaxCost(16 * 1024 * 1024);
+
+#ifdef HAVE_XCOMPOSITE
+    if (QX11Info::isPlatformX11()) {
+        int compositeEvent, compositeError, damageError;
+        if (XCompositeQueryExtension(QX11Info::display(), &compositeEvent, &compositeError) && XDamageQueryExtension(QX11Info::display(), &d->damageEventBase, &damageError)) {
+            int major = 0, minor = 2;
+            XCompositeQueryVersion(QX11Info::display(), &major, &minor);
+            d->available = major > 0 || minor >= 2;
+        }
+    }
+
+    if (d->available) {
+        xcb_connection_t* connection = QX11Info::connection();
+        xcb_intern_atom_reply_t* atomReply = xcb_intern_atom_reply(connection, xcb_intern_atom(connection, false, 18, "_NET_ACTIVE_WINDOW"), nullptr);
+        if (atomReply) {
+            d->activeWindowAtom = atomReply->atom;
+            free(atomReply);
+        }
+
+        QApplication::instance()->installNativeEventFilter(this);
+        connect(DesktopWm::instance(), &DesktopWm::activeWindowChanged, this, &TaskbarThumbnailCache::activeWindowChanged);
+    }
+#endif
+
+    connect(DesktopWm::instance(), &DesktopWm::windowRemoved, this, &TaskbarThumbnailCache::forget);
+}
+
+TaskbarThumbnailCache::~TaskbarThumbnailCache() {
+    for (DesktopWmWindow* window : d->windows.keys()) {
+        forget(window);
+    }
+    QApplication::instance()->removeNativeEventFilter(this);
+    delete d;
+}
+
+bool TaskbarThumbnailCache::isAvailable() {
+    return d->available;
+}
+
+QPixmap TaskbarThumbnailCache::thumbnail(DesktopWmWindowPtr window) {
+    if (!d->available || !window) return QPixmap();
+
+#ifdef HAVE_XCOMPOSITE
+    TaskbarThumbnailWindow& state = d->windows[window];
+    if (state.xWindow == 0) {
+        state.xWindow = findXWindow(window);
+        if (state.xWindow == 0) return QPixmap();
+
+        //Make sure the server keeps an offscreen copy of the window; this does nothing if the compositor already does
+        XCompositeRedirectWindow(QX11Info::display(), state.xWindow, CompositeRedirectAutomatic);
+
+        //Have the server tell us when the window contents change, rather than capturing repeatedly
+        state.damage = XDamageCreate(QX11Info::display(), state.xWindow, XDamageReportNonEmpty);
+        d->windowsByDamage.insert(state.damage, window);
+    }
+
+    QPixmap* cached = d->thumbnails.object(window);
+    PerformanceMonitor::recordCacheLookup("taskbar-thumbnails", cached && !state.dirty);
+    if (cached && !state.dirty) return *cached;
+
+    if (cached && state.lastCapture.isValid() && state.lastCapture.elapsed() < THUMBNAIL_THROTTLE) {
+        //Come back once the throttle has passed
+        if (!state.refreshPending) {
+            state.refreshPending = true;
+            QTimer::singleShot(THUMBNAIL_THROTTLE - state.lastCapture.elapsed(), this, [ = ] {
+                if (!d->windows.contains(window)) return;
+                d->windows[window].refreshPending = false;
+                emit thumbnailInvalidated(window);
+            });
+        }
+        return *cached;
+    }
+
+    QImage image = capture(state.xWindow);
+    state.dirty = false;
+    state.lastCapture.start();
+    if (image.isNull()) return cached ? *cached : QPixmap();
+
+    QPixmap* pixmap = new QPixmap(QPixmap::fromImage(image));
+    QPixmap result = *pixmap;
+    d->thumbnails.insert(window, pixmap, pixmap->width() * pixmap->height() * pixmap->depth() / 8);
+    return result;
+#else
+    return QPixmap();
+#endif
+}
+
+void TaskbarThumbnailCache::forget(DesktopWmWindowPtr window) {
+    d->activatedXWindows.remove(window);
+    if (!d->windows.contains(window)) return;
+    TaskbarThumbnailWindow state = d->windows.take(window);
+    d->thumbnails.remove(window);
+
+#ifdef HAVE_XCOMPOSITE
+    if (state.damage != 0) {
+        d->windowsByDamage.remove(state.damage);
+        XDamageDestroy(QX11Info::display(), state.damage);
+    }
+    if (state.xWindow != 0) {
+        XCompositeUnredirectWindow(QX11Info::display(), state.xWindow, CompositeRedirectAutomatic);
+    }
+#endif
+}
+
+unsigned long TaskbarThumbnailCache::findXWindow(DesktopWmWindowPtr window) {
+#ifdef HAVE_XCOMPOSITE
+    //The active window can be identified exactly straight away
+    if (window == DesktopWm::activeWindow()) activeWindowChanged();
+    if (d->activatedXWindows.contains(window)) return d->activatedXWindows.value(window);
+
+    //The window hasn't been active yet, so find the client whose title and position match.
+    //Send every request before waiting on any reply so the lookup costs a single round trip.
+    xcb_connection_t* connection = QX11Info::connection();
+    xcb_window_t root = QX11Info::appRootWindow();
+
+    xcb_intern_atom_cookie_t clientListAtomCookie = xcb_intern_atom(connection, false, 16, "_NET_CLIENT_LIST");
+    xcb_intern_atom_cookie_t nameAtomCookie = xcb_intern_atom(connection, false, 12, "_NET_WM_NAME");
+    xcb_intern_atom_cookie_t utf8AtomCookie = xcb_intern_atom(connection, false, 11, "UTF8_STRING");
+
+    xcb_atom_t atoms[3] = {XCB_ATOM_NONE, XCB_ATOM_NONE, XCB_ATOM_NONE};
+    xcb_intern_atom_cookie_t atomCookies[3] = {clientListAtomCookie, nameAtomCookie, utf8AtomCookie};
+    for (int i = 0; i < 3; i++) {
+        xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(connection, atomCookies[i], nullptr);
+        if (reply) {
+            atoms[i] = reply->atom;
+            free(reply);
+        }
+    }
+
+    xcb_get_property_reply_t* clientListReply = xcb_get_property_reply(connection, xcb_get_property(connection, false, root, atoms[0], XCB_ATOM_WINDOW, 0, 4096), nullptr);
+    if (!clientListReply) return 0;
+
+    xcb_window_t* clients = static_cast<xcb_window_t*>(xcb_get_property_value(clientListReply));
+    int count = xcb_get_property_value_length(clientListReply) / static_cast<int>(sizeof(xcb_window_t));
+
+    QVector<xcb_get_property_cookie_t> nameCookies;
+    QVector<xcb_translate_coordinates_cookie_t> positionCookies;
+    for (int i = 0; i < count; i++) {
+        nameCookies.append(xcb_get_property(connection, false, clients[i], atoms[1], atoms[2], 0, 1024));
+        positionCookies.append(xcb_translate_coordinates(connection, clients[i], root, 0, 0));
+    }
+
+    QByteArray title = window->title().toUtf8();
+    QPoint position = window->geometry().topLeft();
+    xcb_window_t found = 0;
+    int bestDistance = INT_MAX;
+    bool ambiguous = false;
+    for (int i = 0; i < count; i++) {
+        xcb_get_property_reply_t* nameReply = xcb_get_property_reply(connection, nameCookies.at(i), nullptr);
+        xcb_translate_coordinates_reply_t* positionReply = xcb_translate_coordinates_reply(connection, positionCookies.at(i), nullptr);
+
+        if (nameReply && positionReply) {
+            QByteArray name(static_cast<char*>(xcb_get_property_value(nameReply)), xcb_get_property_value_length(nameReply));
+            if (name == title) {
+                int distance = (QPoint(positionReply->dst_x, positionReply->dst_y) - position).manhattanLength();
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    found = clients[i];
+                    ambiguous = false;
+                } else if (distance == bestDistance) {
+                    ambiguous = true;
+                }
+            }
+        }
+
+        free(nameReply);
+        free(positionReply);
+    }
+    free(clientListReply);
+
+    //Rather show no thumbnail than the contents of another window
+    if (ambiguous) return 0;
+    return found;
+#else
+    Q_UNUSED(window);
+    return 0;
+#endif
+}
+
+void TaskbarThumbnailCache::activeWindowChanged() {
+#ifdef HAVE_XCOMPOSITE
+    DesktopWmWindowPtr window = DesktopWm::activeWindow();
+    if (!window || d->activeWindowAtom == 0) return;
+
+    //Focus changes all the time, so only ask the server about windows that have a thumbnail and aren't known yet
+    if (d->activatedXWindows.contains(window) || !d->windows.contains(window)) return;
+
+    xcb_connection_t* connection = QX11Info::connection();
+    xcb_get_property_reply_t* reply = xcb_get_property_reply(connection, xcb_get_property(connection, false, QX11Info::appRootWindow(), d->activeWindowAtom, XCB_ATOM_WINDOW, 0, 1), nullptr);
+    if (!reply) return;
+
+    xcb_window_t xWindow = 0;
+    if (xcb_get_property_value_length(reply) >= static_cast<int>(sizeof(xcb_window_t))) xWindow = *static_cast<xcb_window_t*>(xcb_get_property_value(reply));
+    free(reply);
+    if (xWindow == 0) return;
+
+    d->activatedXWindows.insert(window, xWindow);
+
+    //If an earlier lookup by title picked another client, start again with the right one
+    if (d->windows.value(window).xWindow != 0 && d->windows.value(window).xWindow != xWindow) {
+        forget(window);
+        d->activatedXWindows.insert(window, xWindow);
+        emit thumbnailInvalidated(window);
+    }
+#endif
+}
+
+QImage TaskbarThumbnailCache::capture(unsigned long xWindow) {
+#ifdef HAVE_XCOMPOSITE
+    Display* dpy = QX11Info::display();
+
+    XWindowAttributes attributes;
+    if (!XGetWindowAttributes(dpy, xWindow, &attributes) || attributes.map_state != IsViewable) return QImage();
+    if (attributes.width <= 0 || attributes.height <= 0) return QImage();
+
+    XRenderPictFormat* sourceFormat = XRenderFindVisualFormat(dpy, attributes.visual);
+    XRenderPictFormat* thumbnailFormat = XRenderFindStandardFormat(dpy, PictStandardARGB32);
+    if (!sourceFormat || !thumbnailFormat) return QImage();
+
+    Pixmap pixmap = XCompositeNameWindowPixmap(dpy, xWindow);
+    if (pixmap == None) return QImage();
+
+    //Have the server scale the window down so only the thumbnail is transferred and nothing is scaled here
+    QSize size = QSize(attributes.width, attributes.height).scaled(SC_DPI_T(QSize(256, 256), QSize), Qt::KeepAspectRatio).boundedTo(QSize(attributes.width, attributes.height));
+    if (size.isEmpty()) size = QSize(1, 1);
+
+    XRenderPictureAttributes pictureAttributes;
+    pictureAttributes.subwindow_mode = IncludeInferiors;
+    Picture source = XRenderCreatePicture(dpy, pixmap, sourceFormat, CPSubwindowMode, &pictureAttributes);
+
+    XTransform transform = {{
+            {XDoubleToFixed(static_cast<double>(attributes.width) / size.width()), 0, 0},
+            {0, XDoubleToFixed(static_cast<double>(attributes.height) / size.height()), 0},
+            {0, 0, XDoubleToFixed(1)}
+        }
+    };
+    XRenderSetPictureTransform(dpy, source, &transform);
+    XRenderSetPictureFilter(dpy, source, FilterGood, nullptr, 0);
+
+    Pixmap thumbnailPixmap = XCreatePixmap(dpy, DefaultRootWindow(dpy), static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()), 32);
+    Picture thumbnail = XRenderCreatePicture(dpy, thumbnailPixmap, thumbnailFormat, 0, nullptr);
+    XRenderComposite(dpy, PictOpSrc, source, None, thumbnail, 0, 0, 0, 0, 0, 0, static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()));
+
+    XImage* xImage = XGetImage(dpy, thumbnailPixmap, 0, 0, static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()), AllPlanes, ZPixmap);
+    QImage image;
+    if (xImage) {
+        if (xImage->bits_per_pixel == 32) {
+            //Formats without alpha are composited as opaque, so the result is always premultiplied ARGB
+            image = QImage(reinterpret_cast<uchar*>(xImage->data), xImage->width, xImage->height, xImage->bytes_per_line, QImage::Format_ARGB32_Premultiplied).copy();
+        }
+        XDestroyImage(xImage);
+    }
+
+    XRenderFreePicture(dpy, thumbnail);
+    XRenderFreePicture(dpy, source);
+    XFreePixmap(dpy, thumbnailPixmap);
+    XFreePixmap(dpy, pixmap);
+    return image;
+#else
+    Q_UNUSED(xWindow);
+    return QImage();
+#endif
+}
+
+bool TaskbarThumbnailCache::nativeEventFilter(const QByteArray& eventType, void* message, long* result) {
+    Q_UNUSED(result);
+#ifdef HAVE_XCOMPOSITE
+    if (eventType != "xcb_generic_event_t") return false;
+
+    xcb_generic_event_t* event = static_cast<xcb_generic_event_t*>(message);
+    if ((event->response_type & ~0x80) != d->damageEventBase + XCB_DAMAGE_NOTIFY) return false;
+
+    xcb_damage_notify_event_t* damageEvent = reinterpret_cast<xcb_damage_notify_event_t*>(event);
+    DesktopWmWindow* window = d->windowsByDamage.value(damageEvent->damage, nullptr);
+    if (!window) return false;
+
+    //Re-arm the damage object and note that the thumbnail is stale; it'll be captured next time it's needed
+    XDamageSubtract(QX11Info::display(), damageEvent->damage, None, None);
+
+    TaskbarThumbnailWindow& state = d->windows[window];
+    if (!state.dirty) {
+        state.dirty = true;
+        emit thumbnailInvalidated(window);
+    }
+#else
+    Q_UNUSED(eventType);
+    Q_UNUSED(message);
+#endif
+    return false;
+}
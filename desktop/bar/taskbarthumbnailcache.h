@@ -0,0 +1,57 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef TASKBARTHUMBNAILCACHE_H
+#define TASKBARTHUMBNAILCACHE_H
+
+#include <QObject>
+#include <QPointer>
+#include <QPixmap>
+#include <QAbstractNativeEventFilter>
+
+class DesktopWmWindow;
+typedef QPointer<DesktopWmWindow> DesktopWmWindowPtr;
+
+struct TaskbarThumbnailCachePrivate;
+class TaskbarThumbnailCache : public QObject, public QAbstractNativeEventFilter {
+        Q_OBJECT
+    public:
+        explicit TaskbarThumbnailCache(QObject* parent = nullptr);
+        ~TaskbarThumbnailCache();
+
+        bool isAvailable();
+        QPixmap thumbnail(DesktopWmWindowPtr window);
+        void forget(DesktopWmWindowPtr window);
+
+    signals:
+        void thumbnailInvalidated(DesktopWmWindowPtr window);
+
+    private:
+        TaskbarThumbnailCachePrivate* d;
+
+        unsigned long findXWindow(DesktopWmWindowPtr window);
+        void activeWindowChanged();
+        QImage capture(unsigned long xWindow);
+
+        // QAbstractNativeEventFilter interface
+    public:
+        bool nativeEventFilter(const QByteArray& eventType, void* message, long* result);
+};
+
+#endif // TASKBARTHUMBNAILCACHE_H
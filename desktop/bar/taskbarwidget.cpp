@@ -20,13 +20,23 @@
 #include "taskbarwidget.h"
 #include "ui_taskbarwidget.h"
 
-#include <QPushButton>
+#include <QPalette>
+#include <QLabel>
+#include <QScreen>
 #include <Wm/desktopwm.h>
 #include <the-libs_global.h>
-#include <Applications/application.h>
+#include <tsettings.h>
+#include "taskbarmodel.h"
+#include "taskbardelegate.h"
+#include "taskbarthumbnailcache.h"
 
 struct TaskbarWidgetPrivate {
-    QMap<DesktopWmWindowPtr, QPushButton*> buttons;
+    TaskbarModel* model;
+    tSettings settings;
+
+    TaskbarThumbnailCache* thumbnails;
+    QLabel* preview;
+    QPersistentModelIndex previewIndex;
 };
 
 TaskbarWidget::TaskbarWidget(QWidget* parent) :
@@ -36,70 +46,86 @@ TaskbarWidget::TaskbarWidget(QWidget* parent) :
 
     d = new TaskbarWidgetPrivate();
 
-    connect(DesktopWm::instance(), &DesktopWm::windowAdded, this, &TaskbarWidget::addWindow);
-    connect(DesktopWm::instance(), &DesktopWm::windowRemoved, this, &TaskbarWidget::removeWindow);
-    connect(DesktopWm::instance(), &DesktopWm::activeWindowChanged, this, &TaskbarWidget::activeWindowChanged);
+    //Every entry is painted by the delegate in one view, rather than having a widget for each window
+    d->model = new TaskbarModel(this);
+    d->model->setGrouped(d->settings.value("Bar/taskbar.group").toBool());
+    ui->taskbarView->setModel(d->model);
+    ui->taskbarView->setItemDelegate(new TaskbarDelegate(this));
+    ui->taskbarView->setWrapping(false);
+    ui->taskbarView->setMouseTracking(true);
+    ui->taskbarView->setFixedHeight(SC_DPI(44));
+
+    QPalette pal = ui->taskbarView->palette();
+    pal.setColor(QPalette::Base, Qt::transparent);
+    ui->taskbarView->setPalette(pal);
+
+    connect(ui->taskbarView, &QListView::clicked, this, &TaskbarWidget::activate);
 
-    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
-        this->addWindow(window);
+    d->thumbnails = new TaskbarThumbnailCache(this);
+    d->preview = new QLabel(this, Qt::ToolTip);
+    d->preview->setMargin(SC_DPI(6));
+    if (d->thumbnails->isAvailable()) {
+        connect(ui->taskbarView, &QListView::entered, this, &TaskbarWidget::showPreview);
+        connect(ui->taskbarView, &QListView::viewportEntered, this, &TaskbarWidget::hidePreview);
+        connect(d->thumbnails, &TaskbarThumbnailCache::thumbnailInvalidated, this, [ = ](DesktopWmWindowPtr window) {
+            //Only recapture while the preview for this window is visible
+            if (d->preview->isVisible() && d->model->windows(d->previewIndex).contains(window)) showPreview(d->previewIndex);
+        });
     }
+    connect(&d->settings, &tSettings::settingChanged, this, [ = ](QString key, QVariant value) {
+        if (key == "Bar/taskbar.group") d->model->setGrouped(value.toBool());
+    });
 }
 
 TaskbarWidget::~TaskbarWidget() {
     delete d;
     delete ui;
-    d = nullptr;
 }
 
-void TaskbarWidget::addWindow(DesktopWmWindowPtr window) {
-    if (!window->shouldShowInTaskbar()) return;
-
-    QPushButton* button = new QPushButton(this);
-    button->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
-    button->setText(window->title());
-    button->setIcon(window->icon());
-    button->setIconSize(SC_DPI_T(QSize(32, 32), QSize));
-    button->setCheckable(true);
-    button->setAutoExclusive(true);
-    connect(button, &QPushButton::clicked, window, [ = ] {
-        window->activate();
-    });
-    connect(button, &QPushButton::destroyed, this, [ = ] {
-        if (d) d->buttons.remove(window);
-    });
+void TaskbarWidget::activate(const QModelIndex& index) {
+    QList<DesktopWmWindowPtr> windows = d->model->windows(index);
+    windows.removeAll(nullptr);
+    if (windows.isEmpty()) return;
 
-    auto updateWindow = [ = ] {
-        ApplicationPointer app = window->application();
-        if (app) {
-            button->setText(app->getProperty("Name").toString());
-            button->setIcon(QIcon::fromTheme(app->getProperty("Icon").toString()));
-        } else {
-            button->setText(window->title());
-            button->setIcon(window->icon());
-        }
-    };
-    updateWindow();
-
-    connect(window, &DesktopWmWindow::titleChanged, button, updateWindow);
-    connect(window, &DesktopWmWindow::iconChanged, button, updateWindow);
-    connect(window, &DesktopWmWindow::applicationChanged, button, updateWindow);
-
-    ui->buttonsLayout->addWidget(button);
-    d->buttons.insert(window, button);
+    //For a group, cycle through its windows each time the entry is clicked
+    int current = windows.indexOf(DesktopWm::activeWindow());
+    windows.at((current + 1) % windows.count())->activate();
 }
 
-void TaskbarWidget::removeWindow(DesktopWmWindowPtr window) {
-    if (d->buttons.contains(window)) {
-        ui->buttonsLayout->removeWidget(d->buttons.value(window));
-        d->buttons.value(window)->deleteLater();
+void TaskbarWidget::showPreview(const QModelIndex& index) {
+    QList<DesktopWmWindowPtr> windows = d->model->windows(index);
+    windows.removeAll(nullptr);
+    if (windows.isEmpty()) {
+        hidePreview();
+        return;
     }
-}
 
-void TaskbarWidget::activeWindowChanged() {
-    for (QPushButton* button : d->buttons.values()) {
-        button->setChecked(false);
+    //Preview the most recently active window in a group
+    DesktopWmWindowPtr window = windows.contains(DesktopWm::activeWindow()) ? DesktopWm::activeWindow() : windows.first();
+    QPixmap thumbnail = d->thumbnails->thumbnail(window);
+    if (thumbnail.isNull()) {
+        hidePreview();
+        return;
     }
 
-    QPushButton* selectedButton = d->buttons.value(DesktopWm::activeWindow(), nullptr);
-    if (selectedButton) selectedButton->setChecked(true);
+    d->previewIndex = index;
+    d->preview->setPixmap(thumbnail);
+    d->preview->adjustSize();
+
+    QRect itemRect = ui->taskbarView->visualRect(index);
+    QPoint pos = ui->taskbarView->viewport()->mapToGlobal(itemRect.bottomLeft());
+    QRect screenGeometry = this->screen()->geometry();
+    if (pos.x() + d->preview->width() > screenGeometry.right()) pos.setX(screenGeometry.right() - d->preview->width());
+    d->preview->move(pos);
+    d->preview->show();
+}
+
+void TaskbarWidget::hidePreview() {
+    d->preview->hide();
+    d->previewIndex = QPersistentModelIndex();
+}
+
+void TaskbarWidget::leaveEvent(QEvent* event) {
+    Q_UNUSED(event);
+    hidePreview();
 }
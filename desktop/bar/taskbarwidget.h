@@ -26,9 +26,6 @@ namespace Ui {
     class TaskbarWidget;
 }
 
-class DesktopWmWindow;
-typedef QPointer<DesktopWmWindow> DesktopWmWindowPtr;
-
 struct TaskbarWidgetPrivate;
 class TaskbarWidget : public QWidget {
         Q_OBJECT
@@ -41,9 +38,11 @@ class TaskbarWidget : public QWidget {
         Ui::TaskbarWidget* ui;
         TaskbarWidgetPrivate* d;
 
-        void addWindow(DesktopWmWindowPtr window);
-        void removeWindow(DesktopWmWindowPtr window);
-        void activeWindowChanged();
+        void activate(const QModelIndex& index);
+        void showPreview(const QModelIndex& index);
+        void hidePreview();
+
+        void leaveEvent(QEvent* event);
 };
 
 #endif // TASKBARWIDGET_H
@@ -21,6 +21,9 @@
 
 #include <QCommandLineParser>
 #include <QTextStream>
+#include <QDBusInterface>
+#include <QDBusReply>
+#include <QJsonDocument>
 #include "plugins/pluginmanager.h"
 #include "server/sessionserver.h"
 
@@ -40,6 +43,12 @@ int CommandLine::parse(QStringList args) {
     QCommandLineOption serverOption("sessionserver", tr("Internal use; the path to a local socket to communicate with the session manager"), tr("path"));
     parser.addOption(serverOption);
 
+    QCommandLineOption performanceOption("performance", tr("Print performance statistics from the running instance of theDesk"));
+    parser.addOption(performanceOption);
+
+    QCommandLineOption collectOption("collect", tr("Start or stop collecting detailed performance statistics in the running instance of theDesk"), tr("on|off"));
+    parser.addOption(collectOption);
+
     QCommandLineOption helpOption = parser.addHelpOption();
     QCommandLineOption versionOption = parser.addVersionOption();
 
@@ -57,6 +66,10 @@ int CommandLine::parse(QStringList args) {
         parser.showVersion();
     }
 
+    if (parser.isSet(performanceOption) || parser.isSet(collectOption)) {
+        return queryPerformance(parser.isSet(collectOption) ? parser.value(collectOption) : "");
+    }
+
     if (parser.isSet(safeOption)) {
         PluginManager::instance()->setSafeMode(true);
     }
@@ -68,3 +81,32 @@ int CommandLine::parse(QStringList args) {
 
     return -1;
 }
+
+int CommandLine::queryPerformance(QString collect) {
+    QTextStream stream(stdout);
+
+    QDBusInterface interface("com.vicr123.thedesk", "/com/vicr123/thedesk/Performance", "com.vicr123.thedesk.Performance");
+    if (!interface.isValid()) {
+        stream << tr("theDesk is not running.") << "\n";
+        return 1;
+    }
+
+    if (!collect.isEmpty()) {
+        if (collect != "on" && collect != "off") {
+            stream << tr("Specify either on or off.") << "\n";
+            return 1;
+        }
+
+        interface.call("SetCollecting", collect == "on");
+        return 0;
+    }
+
+    QDBusReply<QString> statistics = interface.call("Statistics");
+    if (!statistics.isValid()) {
+        stream << statistics.error().message() << "\n";
+        return 1;
+    }
+
+    stream << QJsonDocument::fromJson(statistics.value().toUtf8()).toJson(QJsonDocument::Indented);
+    return 0;
+}
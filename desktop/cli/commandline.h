@@ -29,6 +29,9 @@ class CommandLine : public QObject {
 
         static int parse(QStringList args);
 
+    private:
+        static int queryPerformance(QString collect);
+
     signals:
 
 };
@@ -8,6 +8,17 @@ CONFIG += c++11
 # Include the-libs build tools
 include(/usr/share/the-libs/pri/gentranslations.pri)
 
+unix {
+    CONFIG += link_pkgconfig
+
+    packagesExist(x11 xcomposite xdamage xrender xcb xcb-damage) {
+        message("Building with window thumbnail support");
+        PKGCONFIG += x11 xcomposite xdamage xrender xcb xcb-damage
+        DEFINES += HAVE_XCOMPOSITE
+        QT += x11extras
+    }
+}
+
 QMAKE_POST_LINK += $$QMAKE_COPY_DIR $$quote($$PWD/translations) $$shell_quote($$OUT_PWD) && \
     $$QMAKE_COPY $$quote($$PWD/defaults.conf) $$shell_quote($$OUT_PWD)
 
@@ -27,16 +38,26 @@ SOURCES += \
     bar/barwindow.cpp \
     bar/chunkcontainer.cpp \
     bar/mainbarwidget.cpp \
+    bar/taskbardelegate.cpp \
+    bar/taskbarmodel.cpp \
+    bar/taskbarthumbnailcache.cpp \
     bar/taskbarwidget.cpp \
     cli/commandline.cpp \
     gateway/appselectionmodel.cpp \
     gateway/appselectionmodellistdelegate.cpp \
     gateway/gateway.cpp \
     gateway/maingatewaywidget.cpp \
+    gateway/providers/calculatorsearchprovider.cpp \
+    gateway/providers/fileindex.cpp \
+    gateway/providers/filesearchprovider.cpp \
+    gateway/providers/settingssearchprovider.cpp \
+    gateway/providers/windowsearchprovider.cpp \
     main.cpp \
+    run/executableindex.cpp \
     run/rundialog.cpp \
     session/endsession.cpp \
     session/endsessionbutton.cpp \
+    session/firstframecache.cpp \
     statuscenter/leftpanedelegate.cpp \
     statuscenter/statuscenter.cpp \
     statuscenter/statuscenterleftpane.cpp \
@@ -57,15 +78,25 @@ HEADERS += \
     bar/barwindow.h \
     bar/chunkcontainer.h \
     bar/mainbarwidget.h \
+    bar/taskbardelegate.h \
+    bar/taskbarmodel.h \
+    bar/taskbarthumbnailcache.h \
     bar/taskbarwidget.h \
     cli/commandline.h \
     gateway/appselectionmodel.h \
     gateway/appselectionmodellistdelegate.h \
     gateway/gateway.h \
     gateway/maingatewaywidget.h \
+    gateway/providers/calculatorsearchprovider.h \
+    gateway/providers/fileindex.h \
+    gateway/providers/filesearchprovider.h \
+    gateway/providers/settingssearchprovider.h \
+    gateway/providers/windowsearchprovider.h \
+    run/executableindex.h \
     run/rundialog.h \
     session/endsession.h \
     session/endsessionbutton.h \
+    session/firstframecache.h \
     statuscenter/leftpanedelegate.h \
     statuscenter/statuscenter.h \
     statuscenter/statuscenterleftpane.h \
@@ -22,6 +22,10 @@
 #include <tpromise.h>
 #include <Applications/application.h>
 #include <the-libs_global.h>
+#include <statemanager.h>
+#include <idleworkqueue.h>
+#include <gatewaymanager.h>
+#include <QTimer>
 
 struct AppSelectionModelPrivate {
     QString currentQuery;
@@ -29,6 +33,40 @@ struct AppSelectionModelPrivate {
     QList<ApplicationPointer> apps;
     QList<ApplicationPointer> appsShown;
     QMap<QString, QPixmap> appIcons;
+
+    struct ShownResult {
+        SearchResult result;
+        QPixmap icon;
+    };
+
+    //Results from search providers are shown after the applications, grouped by provider in registration order
+    QList<SearchProvider*> providers;
+    QMap<SearchProvider*, QList<ShownResult>> results;
+    QList<SearchQueryPtr> pendingQueries;
+
+    int resultRow(int row) {
+        return row - appsShown.count();
+    }
+
+    ShownResult* resultAt(int row) {
+        int resultRow = this->resultRow(row);
+        if (resultRow < 0) return nullptr;
+        for (SearchProvider* provider : providers) {
+            QList<ShownResult>& providerResults = results[provider];
+            if (resultRow < providerResults.count()) return &providerResults[resultRow];
+            resultRow -= providerResults.count();
+        }
+        return nullptr;
+    }
+
+    int providerEnd(SearchProvider* provider) {
+        int row = appsShown.count();
+        for (SearchProvider* p : providers) {
+            row += results.value(p).count();
+            if (p == provider) break;
+        }
+        return row;
+    }
 };
 
 AppSelectionModel::AppSelectionModel(QObject* parent)
@@ -39,18 +77,39 @@ AppSelectionModel::AppSelectionModel(QObject* parent)
 }
 
 AppSelectionModel::~AppSelectionModel() {
+    QList<SearchQueryPtr> pendingQueries = d->pendingQueries;
+    d->pendingQueries.clear();
+    for (SearchQueryPtr pendingQuery : pendingQueries) pendingQuery->cancel();
     delete d;
 }
 
 int AppSelectionModel::rowCount(const QModelIndex& parent) const {
     if (parent.isValid())  return 0;
 
-    return d->appsShown.count();
+    int count = d->appsShown.count();
+    for (const QList<AppSelectionModelPrivate::ShownResult>& providerResults : d->results) count += providerResults.count();
+    return count;
 }
 
 QVariant AppSelectionModel::data(const QModelIndex& index, int role) const {
     if (!index.isValid()) return QVariant();
 
+    if (index.row() >= d->appsShown.count()) {
+        AppSelectionModelPrivate::ShownResult* result = d->resultAt(index.row());
+        if (!result) return QVariant();
+
+        if (role == Qt::DisplayRole) {
+            return result->result.title;
+        } else if (role == Qt::DecorationRole) {
+            return result->icon;
+        } else if (role == Qt::UserRole) { //Description
+            return result->result.description;
+        } else if (role == Qt::UserRole + 1) { //Pinned
+            return false;
+        }
+        return QVariant();
+    }
+
     ApplicationPointer a = d->appsShown.at(index.row());
     if (d->appsShown.count() > index.row()) {
         if (role == Qt::DisplayRole) {
@@ -75,18 +134,23 @@ QVariant AppSelectionModel::data(const QModelIndex& index, int role) const {
 }
 
 void AppSelectionModel::search(QString query) {
+    beginResetModel();
     d->currentQuery = query;
     d->appsShown.clear();
+    d->results.clear();
+
+    //Stop any providers still working on the previous query
+    QList<SearchQueryPtr> pendingQueries = d->pendingQueries;
+    d->pendingQueries.clear();
+    for (SearchQueryPtr pendingQuery : pendingQueries) pendingQuery->cancel();
 
     //If there is no current search query, show all apps
     if (query == "") {
         d->appsShown.append(d->apps);
-        emit dataChanged(index(0), index(rowCount()));
+        endResetModel();
         return;
     }
 
-    //TODO: Run the search query past search plugins
-
     for (ApplicationPointer app : d->apps) {
         QStringList possibleWords;
         possibleWords.append(app->getProperty("Name").toString());
@@ -110,7 +174,63 @@ void AppSelectionModel::search(QString query) {
         })));
     }
 
-    emit dataChanged(index(0), index(rowCount()));
+    endResetModel();
+
+    //Search providers report back as they are ready; results are inserted when they arrive
+    querySearchProviders(query);
+}
+
+bool AppSelectionModel::activate(QModelIndex index) {
+    AppSelectionModelPrivate::ShownResult* result = d->resultAt(index.row());
+    if (!result || !result->result.activate) return false;
+
+    result->result.activate();
+    return true;
+}
+
+void AppSelectionModel::querySearchProviders(QString query) {
+    d->providers = StateManager::gatewayManager()->searchProviders();
+    for (SearchProvider* provider : d->providers) {
+        SearchQueryPtr searchQuery = SearchQuery::create(query);
+        d->pendingQueries.append(searchQuery);
+
+        //The query holds these connections, so only refer to it by a plain pointer in here to avoid keeping it alive forever
+        SearchQuery* queryObject = searchQuery.data();
+        connect(queryObject, &SearchQuery::resultsAvailable, this, [ = ](QList<SearchResult> results) {
+            addSearchResults(provider, results);
+        });
+        auto done = [ = ] {
+            //Let go of the query; the provider keeps it alive for as long as it is still working
+            disconnect(queryObject, nullptr, this, nullptr);
+            for (int i = 0; i < d->pendingQueries.count(); i++) {
+                if (d->pendingQueries.at(i).data() == queryObject) {
+                    d->pendingQueries.removeAt(i);
+                    break;
+                }
+            }
+        };
+        connect(queryObject, &SearchQuery::finished, this, done);
+        connect(queryObject, &SearchQuery::cancelled, this, done);
+
+        //A provider that misses its deadline is cancelled so it can't hold up the results
+        QTimer::singleShot(provider->deadline(), queryObject, &SearchQuery::cancel);
+
+        provider->search(searchQuery);
+    }
+}
+
+void AppSelectionModel::addSearchResults(SearchProvider* provider, QList<SearchResult> results) {
+    if (!d->providers.contains(provider)) return;
+
+    QList<AppSelectionModelPrivate::ShownResult> shownResults;
+    for (const SearchResult& result : results) {
+        shownResults.append({result, result.icon.pixmap(SC_DPI_T(QSize(32, 32), QSize))});
+    }
+
+    int row = d->providerEnd(provider);
+    beginInsertRows(QModelIndex(), row, row + shownResults.count() - 1);
+    d->results[provider].append(shownResults);
+    endInsertRows();
 }
 
 void AppSelectionModel::updateData() {
@@ -154,5 +274,13 @@ void AppSelectionModel::updateData() {
         //Perform a search to initialize the list
         search(d->currentQuery);
         emit ready();
+
+        //Render the icons in the background so the first scroll through the list doesn't have to
+        for (ApplicationPointer app : apps) {
+            StateManager::idleWorkQueue()->enqueue(this, [ = ] {
+                if (d->appIcons.contains(app->desktopEntry())) return;
+                d->appIcons.insert(app->desktopEntry(), QIcon::fromTheme(app->getProperty("Icon").toString()).pixmap(SC_DPI_T(QSize(32, 32), QSize)));
+            }, IdleWorkQueue::Low);
+        }
     });
 }
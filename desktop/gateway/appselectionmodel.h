@@ -21,6 +21,7 @@
 #define APPSELECTIONMODEL_H
 
 #include <QAbstractListModel>
+#include <searchprovider.h>
 
 struct AppSelectionModelPrivate;
 class AppSelectionModel : public QAbstractListModel {
@@ -35,6 +36,7 @@ class AppSelectionModel : public QAbstractListModel {
         QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
 
         void search(QString query);
+        bool activate(QModelIndex index);
 
     signals:
         void loading();
@@ -44,6 +46,8 @@ class AppSelectionModel : public QAbstractListModel {
         AppSelectionModelPrivate* d;
 
         void updateData();
+        void querySearchProviders(QString query);
+        void addSearchResults(SearchProvider* provider, QList<SearchResult> results);
 };
 
 
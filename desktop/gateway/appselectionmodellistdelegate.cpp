@@ -84,7 +84,7 @@ void AppSelectionModelListDelegate::paint(QPainter* painter, const QStyleOptionV
 
     if (drawArrows) {
         ApplicationPointer a = index.data(Qt::UserRole + 3).value<ApplicationPointer>();
-        if (a->getStringList("Actions").count() > 0) { //Actions included
+        if (a && a->getStringList("Actions").count() > 0) { //Actions included
             QRect actionsRect;
             actionsRect.setWidth(SC_DPI(16));
             actionsRect.setHeight(SC_DPI(16));
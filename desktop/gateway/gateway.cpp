@@ -30,12 +30,19 @@
 
 #include <statemanager.h>
 #include <gatewaymanager.h>
+#include <animationclock.h>
+#include "providers/windowsearchprovider.h"
+#include "providers/calculatorsearchprovider.h"
+#include "providers/filesearchprovider.h"
+#include "providers/settingssearchprovider.h"
 
 struct GatewayPrivate {
     Gateway* instance = nullptr;
 
     tVariantAnimation* width;
     tSettings settings;
+
+    FileSearchProvider* fileSearchProvider = nullptr;
 };
 
 GatewayPrivate* Gateway::d = new GatewayPrivate();
@@ -54,10 +61,13 @@ Gateway::Gateway() :
     d->width->setEasingCurve(QEasingCurve::OutCubic);
     d->width->setDuration(500);
     connect(d->width, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        this->setFixedWidth(value.toInt());
+        StateManager::animationClock()->scheduleFrameWork(this, "width", [ = ] {
+            this->setFixedWidth(value.toInt());
+        });
     });
+    StateManager::animationClock()->registerAnimation(d->width);
     connect(d->width, &tVariantAnimation::finished, this, [ = ] {
-        if (this->width() == 0) {
+        if (d->width->currentValue().toInt() == 0) {
             QDialog::hide();
             ui->gatewayContainer->clearState();
         }
@@ -68,6 +78,28 @@ Gateway::Gateway() :
     this->setFixedWidth(0);
 
     ui->line->raise();
+
+    StateManager::gatewayManager()->addSearchProvider(new WindowSearchProvider(this));
+    StateManager::gatewayManager()->addSearchProvider(new CalculatorSearchProvider(this));
+    StateManager::gatewayManager()->addSearchProvider(new SettingsSearchProvider(this));
+
+    //File indexing is opt in
+    auto updateFileSearch = [ = ] {
+        if (d->fileSearchProvider) {
+            StateManager::gatewayManager()->removeSearchProvider(d->fileSearchProvider);
+            d->fileSearchProvider->deleteLater();
+            d->fileSearchProvider = nullptr;
+        }
+
+        if (d->settings.value("Gateway/fileIndex.enabled").toBool()) {
+            d->fileSearchProvider = new FileSearchProvider(d->settings.delimitedList("Gateway/fileIndex.directories"), d->settings.value("Gateway/fileIndex.watchBudget").toInt(), this);
+            StateManager::gatewayManager()->addSearchProvider(d->fileSearchProvider);
+        }
+    };
+    connect(&d->settings, &tSettings::settingChanged, this, [ = ](QString key) {
+        if (key.startsWith("Gateway/fileIndex")) updateFileSearch();
+    });
+    updateFileSearch();
 }
 
 void Gateway::resizeEvent(QResizeEvent* event) {
@@ -102,7 +134,8 @@ void Gateway::show() {
     this->setFixedHeight(screen->geometry().height());
     this->move(screen->geometry().topLeft() - QPoint(0, 1));
 
-    d->width->setStartValue(this->width());
+    //The width is applied at the end of the frame, so start from the animation's value rather than the window's
+    d->width->setStartValue(d->width->currentValue().toInt());
     d->width->setEndValue(ui->gatewayContainer->sizeHint().width() + 1);
     d->width->stop();
     d->width->start();
@@ -112,7 +145,7 @@ void Gateway::show() {
 }
 
 void Gateway::close() {
-    d->width->setStartValue(this->width());
+    d->width->setStartValue(d->width->currentValue().toInt());
     d->width->setEndValue(0);
     d->width->stop();
     d->width->start();
@@ -29,6 +29,9 @@
 #include "session/endsession.h"
 #include <statemanager.h>
 #include <powermanager.h>
+#include <launchstatistics.h>
+#include <QProcess>
+#include <QFileInfo>
 
 struct MainGatewayWidgetPrivate {
     AppSelectionModel* model;
@@ -97,10 +100,45 @@ void MainGatewayWidget::on_searchBox_returnPressed() {
 }
 
 void MainGatewayWidget::launch(QModelIndex applicationIndex) {
-    applicationIndex.data(Qt::UserRole + 3).value<ApplicationPointer>()->launch();
+    ApplicationPointer application = applicationIndex.data(Qt::UserRole + 3).value<ApplicationPointer>();
+    if (!application) {
+        //This is a result from a search provider
+        if (d->model->activate(applicationIndex)) emit closeGateway();
+        return;
+    }
+
+    application->launch();
+    StateManager::launchStatistics()->recordLaunch(launchedProgram(application->getProperty("Exec").toString(), application->getProperty("TryExec").toString()));
     emit closeGateway();
 }
 
+QString MainGatewayWidget::launchedProgram(QString exec, QString tryExec) {
+    //Look through launcher wrappers so that the application itself is recorded
+    QStringList parts = QProcess::splitCommand(exec);
+    while (!parts.isEmpty()) {
+        QString program = QFileInfo(parts.first()).fileName();
+        if (program == "flatpak") {
+            //The application's files live inside the sandbox, so there is nothing useful to read ahead
+            return "";
+        } else if (program == "env") {
+            parts.removeFirst();
+            while (!parts.isEmpty() && (parts.first().startsWith("-") || parts.first().contains("="))) parts.removeFirst();
+        } else if (program == "sh" || program == "bash") {
+            parts.removeFirst();
+            bool command = false;
+            while (!parts.isEmpty() && parts.first().startsWith("-")) {
+                if (parts.takeFirst() == "-c") command = true;
+            }
+            if (command) parts = QProcess::splitCommand(parts.value(0));
+        } else {
+            break;
+        }
+    }
+
+    if (!tryExec.isEmpty()) return tryExec;
+    return parts.value(0);
+}
+
 void MainGatewayWidget::changeEvent(QEvent* event) {
     if (event->type() == QEvent::LanguageChange) {
         ui->retranslateUi(this);
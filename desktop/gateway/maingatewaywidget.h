@@ -55,6 +55,7 @@ class MainGatewayWidget : public QWidget {
         MainGatewayWidgetPrivate* d;
 
         void launch(QModelIndex applicationIndex);
+        static QString launchedProgram(QString exec, QString tryExec);
 
         void changeEvent(QEvent* event);
 };
@@ -0,0 +1,154 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "calculatorsearchprovider.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QLocale>
+#include <QRegularExpression>
+#include <cmath>
+
+namespace {
+    //Recursive descent over + - * / ^ and parentheses
+    struct ExpressionParser {
+        QString expression;
+        int pos = 0;
+        bool ok = true;
+
+        QChar peek() {
+            while (pos < expression.length() && expression.at(pos).isSpace()) pos++;
+            if (pos >= expression.length()) return QChar();
+            return expression.at(pos);
+        }
+
+        double parseExpression() {
+            double value = parseTerm();
+            while (ok) {
+                QChar c = peek();
+                if (c == '+') {
+                    pos++;
+                    value += parseTerm();
+                } else if (c == '-') {
+                    pos++;
+                    value -= parseTerm();
+                } else {
+                    break;
+                }
+            }
+            return value;
+        }
+
+        double parseTerm() {
+            double value = parseFactor();
+            while (ok) {
+                QChar c = peek();
+                if (c == '*' || c == QChar(0xD7)) {
+                    pos++;
+                    value *= parseFactor();
+                } else if (c == '/' || c == QChar(0xF7)) {
+                    pos++;
+                    value /= parseFactor();
+                } else {
+                    break;
+                }
+            }
+            return value;
+        }
+
+        double parseFactor() {
+            double value = parseUnary();
+            if (ok && peek() == '^') {
+                pos++;
+                value = std::pow(value, parseFactor());
+            }
+            return value;
+        }
+
+        double parseUnary() {
+            QChar c = peek();
+            if (c == '-') {
+                pos++;
+                return -parseUnary();
+            } else if (c == '+') {
+                pos++;
+                return parseUnary();
+            } else if (c == '(') {
+                pos++;
+                double value = parseExpression();
+                if (peek() != ')') {
+                    ok = false;
+                    return 0;
+                }
+                pos++;
+                return value;
+            }
+
+            int start = pos;
+            while (pos < expression.length() && (expression.at(pos).isDigit() || expression.at(pos) == '.')) pos++;
+
+            bool numberOk;
+            double value = expression.mid(start, pos - start).toDouble(&numberOk);
+            if (!numberOk) ok = false;
+            return value;
+        }
+    };
+}
+
+CalculatorSearchProvider::CalculatorSearchProvider(QObject* parent) : SearchProvider(parent) {
+
+}
+
+QString CalculatorSearchProvider::name() {
+    return tr("Calculator");
+}
+
+void CalculatorSearchProvider::search(SearchQueryPtr query) {
+    QString expression = query->query();
+    if (expression.startsWith("=")) expression.remove(0, 1);
+
+    //Only treat the query as a calculation if it actually has an operation in it
+    static const QRegularExpression operatorExpression("[-+*/^()×÷]");
+    double value;
+    if (expression.contains(operatorExpression) && evaluate(expression, &value)) {
+        QString answer = QLocale().toString(value, 'g', 12);
+
+        SearchResult result;
+        result.title = QStringLiteral("= %1").arg(answer);
+        result.description = tr("Copy to Clipboard");
+        result.icon = QIcon::fromTheme("accessories-calculator");
+        result.activate = [ = ] {
+            QApplication::clipboard()->setText(answer);
+        };
+        query->addResults({result});
+    }
+
+    query->finish();
+}
+
+bool CalculatorSearchProvider::evaluate(QString expression, double* result) {
+    ExpressionParser parser;
+    parser.expression = expression;
+
+    double value = parser.parseExpression();
+    if (!parser.ok || !parser.peek().isNull() || !std::isfinite(value)) return false;
+
+    *result = value;
+    return true;
+}
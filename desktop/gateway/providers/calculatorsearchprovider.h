@@ -0,0 +1,36 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef CALCULATORSEARCHPROVIDER_H
+#define CALCULATORSEARCHPROVIDER_H
+
+#include <searchprovider.h>
+
+class CalculatorSearchProvider : public SearchProvider {
+        Q_OBJECT
+    public:
+        explicit CalculatorSearchProvider(QObject* parent = nullptr);
+
+        QString name() override;
+        void search(SearchQueryPtr query) override;
+
+        static bool evaluate(QString expression, double* result);
+};
+
+#endif // CALCULATORSEARCHPROVIDER_H
@@ -0,0 +1,484 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "fileindex.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QTimer>
+#include <QSet>
+#include <QLoggingCategory>
+#include <idleworkqueue.h>
+#include <statemanager.h>
+
+Q_LOGGING_CATEGORY(fileIndexLog, "thedesk.gateway.fileindex", QtInfoMsg)
+
+#define FILE_INDEX_MAGIC 0x54444649
+#define FILE_INDEX_VERSION 1
+
+//Queries this short match too much of the index to walk while typing, so their results are worked out ahead of time
+#define FILE_INDEX_SHORT_QUERY_LENGTH 2
+#define FILE_INDEX_SHORT_QUERY_RESULTS 16
+
+//Longest stretch of the key table a single search walks
+#define FILE_INDEX_SEARCH_SCAN_LIMIT 2048
+
+//How often to crawl again for changes in directories that aren't watched
+#define FILE_INDEX_RECRAWL_INTERVAL 1800000
+
+struct FileIndexNode {
+    QString name;
+    qint64 lastModified;
+    bool isDir;
+};
+
+struct FileIndexDirectory {
+    qint64 lastModified = 0;
+    QVector<FileIndexNode> children;
+};
+
+typedef QHash<QString, FileIndexDirectory> FileIndexDirectories;
+
+struct FileIndexScan {
+    QString directory;
+    bool exists = false;
+    bool unchanged = false;
+    FileIndexDirectory contents;
+};
+
+struct FileIndexTable {
+    struct Entry {
+        QString path;
+        QString name; //Lower case, for matching
+        qint64 lastModified;
+        bool isDir;
+    };
+
+    //Every word of every file name is a key, so a query matches the start of any word in a name
+    struct Key {
+        int entry;
+        int offset;
+    };
+
+    QVector<Entry> entries;
+    QVector<Key> keys;
+
+    //Most recently modified entries for each short prefix, newest first
+    QHash<QString, QVector<int>> shortQueries;
+
+    QStringView keyAt(const Key& key) const {
+        return QStringView(entries.at(key.entry).name).mid(key.offset);
+    }
+
+    //Keep the newest entries in order, skipping ones already present since a file can match through several words
+    void addToTop(QVector<int>& top, int entry, int limit) const {
+        qint64 lastModified = entries.at(entry).lastModified;
+        if (top.count() == limit && lastModified <= entries.at(top.last()).lastModified) return;
+        if (top.contains(entry)) return;
+
+        auto position = std::upper_bound(top.begin(), top.end(), lastModified, [this](qint64 value, int other) {
+            return value > entries.at(other).lastModified;
+        });
+        top.insert(position, entry);
+        if (top.count() > limit) top.removeLast();
+    }
+};
+
+struct FileIndexPrivate {
+    QStringList roots;
+    int watchBudget;
+
+    FileIndexDirectories directories;
+    FileIndexTable table;
+    int tableGeneration = 0;
+    QTimer* rebuildTimer;
+    QTimer* saveTimer;
+    bool unsaved = false;
+
+    QStringList crawlQueue;
+    bool crawling = false;
+    QElapsedTimer crawlTimer;
+    QTimer* recrawlTimer;
+    QSet<QString> pendingScans;
+
+    QFileSystemWatcher* watcher;
+    QSet<QString> watched;
+
+    static QString indexPath() {
+        QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+        return cacheDir.absoluteFilePath("theDesk/fileindex");
+    }
+};
+
+FileIndex::FileIndex(QStringList roots, int watchBudget, QObject* parent) : QObject(parent) {
+    d = new FileIndexPrivate();
+    d->watchBudget = watchBudget;
+
+    for (QString root : roots) {
+        root = QDir::cleanPath(QDir::home().absoluteFilePath(root));
+        if (d->roots.contains(root) || !QFileInfo(root).isDir()) continue;
+        d->roots.append(root);
+    }
+
+    d->watcher = new QFileSystemWatcher(this);
+    connect(d->watcher, &QFileSystemWatcher::directoryChanged, this, [ = ](QString directory) {
+        scanDirectory(directory, false);
+    });
+
+    //Changes tend to come in bursts, so wait for things to settle before rebuilding the table or writing it out
+    d->rebuildTimer = new QTimer(this);
+    d->rebuildTimer->setInterval(1000);
+    d->rebuildTimer->setSingleShot(true);
+    connect(d->rebuildTimer, &QTimer::timeout, this, [ = ] {
+        StateManager::idleWorkQueue()->enqueue(this, [ = ] {
+            rebuildTable();
+        });
+    });
+
+    d->saveTimer = new QTimer(this);
+    d->saveTimer->setInterval(30000);
+    d->saveTimer->setSingleShot(true);
+    connect(d->saveTimer, &QTimer::timeout, this, &FileIndex::save);
+
+    d->recrawlTimer = new QTimer(this);
+    d->recrawlTimer->setInterval(FILE_INDEX_RECRAWL_INTERVAL);
+    connect(d->recrawlTimer, &QTimer::timeout, this, &FileIndex::crawl);
+
+    load();
+}
+
+FileIndex::~FileIndex() {
+    delete d;
+}
+
+QList<FileIndex::Match> FileIndex::search(QString query, int limit) {
+    QList<Match> matches;
+    QString needle = query.toLower();
+    if (needle.isEmpty()) return matches;
+
+    FileIndexTable& table = d->table;
+    QVector<int> entries;
+    if (needle.length() <= FILE_INDEX_SHORT_QUERY_LENGTH && limit <= FILE_INDEX_SHORT_QUERY_RESULTS) {
+        entries = table.shortQueries.value(needle).mid(0, limit);
+    } else if (limit > 0) {
+        auto key = std::lower_bound(table.keys.constBegin(), table.keys.constEnd(), needle, [&table](const FileIndexTable::Key & key, const QString & value) {
+            return table.keyAt(key) < QStringView(value);
+        });
+
+        //Keep the most recently modified matches, since those are most likely what the user is looking for. Longer
+        //queries have short prefix ranges, but stop after a fixed number of keys so a search never stalls typing.
+        auto end = table.keys.constEnd();
+        if (end - key > FILE_INDEX_SEARCH_SCAN_LIMIT) end = key + FILE_INDEX_SEARCH_SCAN_LIMIT;
+        for (; key != end; key++) {
+            if (!table.keyAt(*key).startsWith(needle)) break;
+            table.addToTop(entries, key->entry, limit);
+        }
+    }
+
+    //Edits to a file don't change its directory, so the stored times can be out of date. Checking the few results is cheap.
+    bool changed = false;
+    for (int entry : qAsConst(entries)) {
+        FileIndexTable::Entry& e = table.entries[entry];
+        QFileInfo info(e.path);
+        if (!info.exists()) continue;
+
+        qint64 lastModified = info.lastModified().toMSecsSinceEpoch();
+        if (lastModified != e.lastModified) {
+            e.lastModified = lastModified;
+            updateLastModified(e.path, lastModified);
+            changed = true;
+        }
+        matches.append({e.path, e.lastModified, e.isDir});
+    }
+
+    if (changed) {
+        std::sort(matches.begin(), matches.end(), [ = ](const Match & first, const Match & second) {
+            return first.lastModified > second.lastModified;
+        });
+        invalidateTable();
+    }
+    return matches;
+}
+
+void FileIndex::load() {
+    QStringList roots = d->roots;
+    IdleWorkQueue::compute<FileIndexDirectories>(this, [ = ] {
+        FileIndexDirectories directories;
+
+        QFile file(FileIndexPrivate::indexPath());
+        if (!file.open(QFile::ReadOnly)) return directories;
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_12);
+
+        quint32 magic, version;
+        QStringList indexedRoots;
+        stream >> magic >> version >> indexedRoots;
+        if (magic != FILE_INDEX_MAGIC || version != FILE_INDEX_VERSION || indexedRoots != roots) return directories;
+
+        quint32 directoryCount;
+        stream >> directoryCount;
+        for (quint32 i = 0; i < directoryCount; i++) {
+            QString path;
+            FileIndexDirectory directory;
+            quint32 childCount;
+            stream >> path >> directory.lastModified >> childCount;
+
+            for (quint32 j = 0; j < childCount && stream.status() == QDataStream::Ok; j++) {
+                FileIndexNode node;
+                stream >> node.name >> node.lastModified >> node.isDir;
+                directory.children.append(node);
+            }
+
+            //Throw away a truncated index rather than showing half of it
+            if (stream.status() != QDataStream::Ok) return FileIndexDirectories();
+            directories.insert(path, directory);
+        }
+
+        return directories;
+    }, [ = ](FileIndexDirectories directories) {
+        d->directories = directories;
+        rebuildTable();
+
+        //Bring the stored index up to date; directories that haven't changed since it was written are not listed again
+        crawl();
+        d->recrawlTimer->start();
+    });
+}
+
+void FileIndex::crawl() {
+    if (d->crawling) return;
+
+    d->crawlQueue = d->roots;
+    d->crawling = true;
+    d->crawlTimer.start();
+    crawlNext();
+}
+
+void FileIndex::save() {
+    d->saveTimer->stop();
+    d->unsaved = false;
+
+    FileIndexDirectories directories = d->directories;
+    QStringList roots = d->roots;
+    IdleWorkQueue::compute<qint64>(this, [ = ] {
+        QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+        cacheDir.mkpath("theDesk");
+
+        QSaveFile file(FileIndexPrivate::indexPath());
+        if (!file.open(QSaveFile::WriteOnly)) return qint64(-1);
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_12);
+        stream << quint32(FILE_INDEX_MAGIC) << quint32(FILE_INDEX_VERSION) << roots;
+        stream << quint32(directories.count());
+        for (auto i = directories.constBegin(); i != directories.constEnd(); i++) {
+            stream << i.key() << i.value().lastModified << quint32(i.value().children.count());
+            for (const FileIndexNode& node : i.value().children) {
+                stream << node.name << node.lastModified << node.isDir;
+            }
+        }
+
+        qint64 size = file.size();
+        if (!file.commit()) return qint64(-1);
+        return size;
+    }, [ = ](qint64 size) {
+        if (size >= 0) qCDebug(fileIndexLog) << "File index:" << directories.count() << "directories," << size << "bytes on disk";
+    });
+}
+
+void FileIndex::crawlNext() {
+    //Watched directories are kept up to date by the watcher, so only walk through them to reach the rest
+    while (!d->crawlQueue.isEmpty() && d->watched.contains(d->crawlQueue.first())) {
+        QString directory = d->crawlQueue.takeFirst();
+        for (const FileIndexNode& node : d->directories.value(directory).children) {
+            if (node.isDir) d->crawlQueue.append(directory + "/" + node.name);
+        }
+    }
+
+    if (d->crawlQueue.isEmpty()) {
+        if (d->crawling) {
+            d->crawling = false;
+            qCDebug(fileIndexLog) << "File index crawl finished after" << d->crawlTimer.elapsed() << "ms";
+            if (d->unsaved) save();
+        }
+        return;
+    }
+
+    //Only list one directory per idle slice so indexing never competes with the user
+    QString directory = d->crawlQueue.takeFirst();
+    StateManager::idleWorkQueue()->enqueue(this, [ = ] {
+        scanDirectory(directory, true);
+    }, IdleWorkQueue::Low);
+}
+
+void FileIndex::scanDirectory(QString directory, bool crawl) {
+    if (!crawl) {
+        if (d->pendingScans.contains(directory)) return;
+        d->pendingScans.insert(directory);
+    }
+
+    //Changes to files inside a directory don't touch its modification time, so only the crawl can skip unchanged directories
+    qint64 knownModified = crawl && d->directories.contains(directory) ? d->directories.value(directory).lastModified : -1;
+    IdleWorkQueue::compute<FileIndexScan>(this, [ = ] {
+        FileIndexScan scan;
+        scan.directory = directory;
+
+        QFileInfo info(directory);
+        scan.exists = info.isDir();
+        if (!scan.exists) return scan;
+
+        scan.contents.lastModified = info.lastModified().toMSecsSinceEpoch();
+        if (scan.contents.lastModified == knownModified) {
+            scan.unchanged = true;
+            return scan;
+        }
+
+        for (const QFileInfo& file : QDir(directory).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::NoSymLinks)) {
+            scan.contents.children.append({file.fileName(), file.lastModified().toMSecsSinceEpoch(), file.isDir()});
+        }
+        return scan;
+    }, [ = ](FileIndexScan scan) {
+        if (!crawl) d->pendingScans.remove(directory);
+        applyScan(scan, crawl);
+        if (crawl) crawlNext();
+    });
+}
+
+void FileIndex::applyScan(const FileIndexScan& scan, bool crawl) {
+    if (!scan.exists) {
+        removeDirectory(scan.directory);
+        return;
+    }
+
+    if (!scan.unchanged) {
+        QSet<QString> subdirectories;
+        for (const FileIndexNode& node : scan.contents.children) {
+            if (node.isDir) subdirectories.insert(node.name);
+        }
+
+        FileIndexDirectory previous = d->directories.value(scan.directory);
+        for (const FileIndexNode& node : previous.children) {
+            if (node.isDir && !subdirectories.contains(node.name)) removeDirectory(scan.directory + "/" + node.name);
+        }
+
+        d->directories.insert(scan.directory, scan.contents);
+        invalidateTable();
+
+        //Pick up directories that were created or moved in since we last looked
+        if (!crawl) {
+            for (QString subdirectory : subdirectories) {
+                QString path = scan.directory + "/" + subdirectory;
+                if (!d->directories.contains(path)) scanDirectory(path, false);
+            }
+        }
+    }
+
+    watchDirectory(scan.directory);
+
+    if (crawl) {
+        for (const FileIndexNode& node : d->directories.value(scan.directory).children) {
+            if (node.isDir) d->crawlQueue.append(scan.directory + "/" + node.name);
+        }
+    }
+}
+
+void FileIndex::removeDirectory(QString directory) {
+    FileIndexDirectory contents = d->directories.take(directory);
+    for (const FileIndexNode& node : contents.children) {
+        if (node.isDir) removeDirectory(directory + "/" + node.name);
+    }
+
+    if (d->watched.remove(directory)) d->watcher->removePath(directory);
+    invalidateTable();
+}
+
+void FileIndex::watchDirectory(QString directory) {
+    //Each watch costs an inotify watch descriptor, which are limited per user. The crawl is breadth first, so the
+    //directories closest to the roots are the ones that get watched; anything deeper is refreshed by the periodic crawl.
+    if (d->watched.contains(directory) || d->watched.count() >= d->watchBudget) return;
+    if (d->watcher->addPath(directory)) d->watched.insert(directory);
+}
+
+void FileIndex::updateLastModified(QString path, qint64 lastModified) {
+    int separator = path.lastIndexOf("/");
+    auto directory = d->directories.find(path.left(separator));
+    if (directory == d->directories.end()) return;
+
+    QString name = path.mid(separator + 1);
+    for (FileIndexNode& node : directory->children) {
+        if (node.name == name) {
+            node.lastModified = lastModified;
+            return;
+        }
+    }
+}
+
+void FileIndex::invalidateTable() {
+    d->unsaved = true;
+    d->rebuildTimer->start();
+    if (!d->crawling) d->saveTimer->start();
+}
+
+void FileIndex::rebuildTable() {
+    FileIndexDirectories directories = d->directories;
+    int generation = ++d->tableGeneration;
+    IdleWorkQueue::compute<FileIndexTable>(this, [ = ] {
+        FileIndexTable table;
+        for (auto i = directories.constBegin(); i != directories.constEnd(); i++) {
+            for (const FileIndexNode& node : i.value().children) {
+                FileIndexTable::Entry entry;
+                entry.path = i.key() + "/" + node.name;
+                entry.name = node.name.toLower();
+                entry.lastModified = node.lastModified;
+                entry.isDir = node.isDir;
+
+                int index = table.entries.count();
+                for (int offset = 0; offset < entry.name.length(); offset++) {
+                    if (offset == 0 || (!entry.name.at(offset - 1).isLetterOrNumber() && entry.name.at(offset).isLetterOrNumber())) {
+                        table.keys.append({index, offset});
+                    }
+                }
+                table.entries.append(entry);
+            }
+        }
+
+        std::sort(table.keys.begin(), table.keys.end(), [&table](const FileIndexTable::Key & first, const FileIndexTable::Key & second) {
+            return table.keyAt(first) < table.keyAt(second);
+        });
+
+        for (const FileIndexTable::Key& key : qAsConst(table.keys)) {
+            QStringView name = table.keyAt(key);
+            for (int length = 1; length <= FILE_INDEX_SHORT_QUERY_LENGTH && length <= name.length(); length++) {
+                table.addToTop(table.shortQueries[name.left(length).toString()], key.entry, FILE_INDEX_SHORT_QUERY_RESULTS);
+            }
+        }
+        return table;
+    }, [ = ](FileIndexTable table) {
+        //A newer rebuild has been started since this one
+        if (generation != d->tableGeneration) return;
+        d->table = table;
+    });
+}
@@ -0,0 +1,57 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef FILEINDEX_H
+#define FILEINDEX_H
+
+#include <QObject>
+
+struct FileIndexScan;
+struct FileIndexPrivate;
+class FileIndex : public QObject {
+        Q_OBJECT
+    public:
+        explicit FileIndex(QStringList roots, int watchBudget, QObject* parent = nullptr);
+        ~FileIndex();
+
+        struct Match {
+            QString path;
+            qint64 lastModified;
+            bool isDir;
+        };
+
+        QList<Match> search(QString query, int limit);
+
+    private:
+        FileIndexPrivate* d;
+
+        void load();
+        void save();
+        void crawl();
+        void crawlNext();
+        void scanDirectory(QString directory, bool crawl);
+        void applyScan(const FileIndexScan& scan, bool crawl);
+        void removeDirectory(QString directory);
+        void watchDirectory(QString directory);
+        void updateLastModified(QString path, qint64 lastModified);
+        void invalidateTable();
+        void rebuildTable();
+};
+
+#endif // FILEINDEX_H
@@ -0,0 +1,75 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "filesearchprovider.h"
+
+#include "fileindex.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QUrl>
+#include <QDesktopServices>
+#include <QMimeDatabase>
+
+struct FileSearchProviderPrivate {
+    FileIndex* index;
+    QMimeDatabase mimeDatabase;
+};
+
+FileSearchProvider::FileSearchProvider(QStringList directories, int watchBudget, QObject* parent) : SearchProvider(parent) {
+    d = new FileSearchProviderPrivate();
+    d->index = new FileIndex(directories, watchBudget, this);
+}
+
+FileSearchProvider::~FileSearchProvider() {
+    delete d;
+}
+
+QString FileSearchProvider::name() {
+    return tr("Files");
+}
+
+void FileSearchProvider::search(SearchQueryPtr query) {
+    //Single characters match far too much to be useful
+    if (query->query().length() < 2) {
+        query->finish();
+        return;
+    }
+
+    QList<SearchResult> results;
+    for (const FileIndex::Match& match : d->index->search(query->query(), 5)) {
+        QFileInfo file(match.path);
+
+        SearchResult result;
+        result.title = file.fileName();
+        result.description = QStringLiteral("~/%1").arg(QDir::home().relativeFilePath(file.path()));
+        if (match.isDir) {
+            result.icon = QIcon::fromTheme("folder");
+        } else {
+            QMimeType mimeType = d->mimeDatabase.mimeTypeForFile(match.path, QMimeDatabase::MatchExtension);
+            result.icon = QIcon::fromTheme(mimeType.iconName(), QIcon::fromTheme(mimeType.genericIconName()));
+        }
+        result.activate = [ = ] {
+            QDesktopServices::openUrl(QUrl::fromLocalFile(match.path));
+        };
+        results.append(result);
+    }
+
+    query->addResults(results);
+    query->finish();
+}
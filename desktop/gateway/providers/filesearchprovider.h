@@ -0,0 +1,39 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef FILESEARCHPROVIDER_H
+#define FILESEARCHPROVIDER_H
+
+#include <searchprovider.h>
+
+struct FileSearchProviderPrivate;
+class FileSearchProvider : public SearchProvider {
+        Q_OBJECT
+    public:
+        explicit FileSearchProvider(QStringList directories, int watchBudget, QObject* parent = nullptr);
+        ~FileSearchProvider();
+
+        QString name() override;
+        void search(SearchQueryPtr query) override;
+
+    private:
+        FileSearchProviderPrivate* d;
+};
+
+#endif // FILESEARCHPROVIDER_H
@@ -0,0 +1,56 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "settingssearchprovider.h"
+
+#include <QPointer>
+#include <statemanager.h>
+#include <statuscentermanager.h>
+#include <statuscenterpane.h>
+
+SettingsSearchProvider::SettingsSearchProvider(QObject* parent) : SearchProvider(parent) {
+
+}
+
+QString SettingsSearchProvider::name() {
+    return tr("Settings");
+}
+
+void SettingsSearchProvider::search(SearchQueryPtr query) {
+    StatusCenterManager* manager = StateManager::statusCenterManager();
+
+    QList<SearchResult> results;
+    for (StatusCenterPane* pane : manager->panes()) {
+        if (!pane->displayName().contains(query->query(), Qt::CaseInsensitive)) continue;
+
+        SearchResult result;
+        result.title = pane->displayName();
+        result.description = manager->paneType(pane) == StatusCenterManager::SystemSettings ? tr("System Settings") : tr("Status Center");
+        result.icon = pane->icon();
+
+        QPointer<StatusCenterPane> panePointer = pane;
+        result.activate = [ = ] {
+            if (panePointer) StateManager::statusCenterManager()->showPane(panePointer);
+        };
+        results.append(result);
+    }
+
+    query->addResults(results);
+    query->finish();
+}
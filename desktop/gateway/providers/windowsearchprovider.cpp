@@ -0,0 +1,60 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "windowsearchprovider.h"
+
+#include <Wm/desktopwm.h>
+#include <Applications/application.h>
+
+WindowSearchProvider::WindowSearchProvider(QObject* parent) : SearchProvider(parent) {
+
+}
+
+QString WindowSearchProvider::name() {
+    return tr("Open Windows");
+}
+
+void WindowSearchProvider::search(SearchQueryPtr query) {
+    QList<SearchResult> results;
+    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
+        ApplicationPointer app = window->application();
+
+        QStringList possibleWords;
+        possibleWords.append(window->title());
+        if (app) possibleWords.append(app->getProperty("Name").toString());
+
+        bool matches = false;
+        for (QString s : possibleWords) {
+            if (s.contains(query->query(), Qt::CaseInsensitive)) matches = true;
+        }
+        if (!matches) continue;
+
+        SearchResult result;
+        result.title = window->title();
+        result.description = tr("Switch to Window");
+        result.icon = app ? QIcon::fromTheme(app->getProperty("Icon").toString()) : window->icon();
+        result.activate = [ = ] {
+            if (window) window->activate();
+        };
+        results.append(result);
+    }
+
+    query->addResults(results);
+    query->finish();
+}
@@ -26,6 +26,8 @@
 #include <powermanager.h>
 #include <localemanager.h>
 #include <statuscentermanager.h>
+#include <stallwatchdog.h>
+#include <performancemonitor.h>
 #include <Wm/desktopwm.h>
 #include <Screens/screendaemon.h>
 
@@ -33,6 +35,7 @@
 #include "bar/barwindow.h"
 #include "background/background.h"
 #include "session/endsession.h"
+#include "session/firstframecache.h"
 #include "cli/commandline.h"
 #include "server/sessionserver.h"
 #include <onboarding/onboardingcontroller.h>
@@ -54,6 +57,9 @@ int main(int argc, char* argv[]) {
     tSettings::registerDefaults(a.applicationDirPath() + "/defaults.conf");
     tSettings::registerDefaults("/etc/theSuite/theDesk/defaults.conf");
 
+    //Start watching the main thread for stalls if enabled
+    StallWatchdog::instance();
+
     //Parse command line arguments
     int parseResult = CommandLine::parse(a.arguments());
     if (parseResult != -1) {
@@ -66,6 +72,12 @@ int main(int argc, char* argv[]) {
         if (results.result) PluginManager::instance()->setSafeMode(true);
     }
 
+    //Show what the last session looked like straight away while the shell loads behind it
+    if (FirstFrameCache::instance()->showPlaceholders()) SessionServer::instance()->hideSplashes();
+
+    //Expose performance statistics on the session bus
+    PerformanceMonitor::instance();
+
     DesktopWm::instance();
     PluginManager::instance()->scanPlugins();
 
@@ -89,6 +101,7 @@ int main(int argc, char* argv[]) {
     w.show();
 
     QTimer::singleShot(0, [ = ] {
+        FirstFrameCache::instance()->dismissPlaceholder("bar", qApp->primaryScreen());
         SessionServer::instance()->hideSplashes();
         SessionServer::instance()->performAutostart();
     });
@@ -0,0 +1,104 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "executableindex.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <QFileSystemWatcher>
+#include <QStandardPaths>
+#include <idleworkqueue.h>
+#include <statemanager.h>
+#include <launchstatistics.h>
+
+struct ExecutableIndexPrivate {
+    QHash<QString, QStringList> executables;
+    QStringList directories;
+    QFileSystemWatcher* watcher;
+};
+
+ExecutableIndex::ExecutableIndex(QObject* parent) : QObject(parent) {
+    d = new ExecutableIndexPrivate();
+
+    //Rescan a directory whenever something is installed into or removed from it
+    d->watcher = new QFileSystemWatcher(this);
+    connect(d->watcher, &QFileSystemWatcher::directoryChanged, this, &ExecutableIndex::scanDirectory);
+
+    for (QString directory : qEnvironmentVariable("PATH").split(":", Qt::SkipEmptyParts)) {
+        directory = QDir::cleanPath(directory);
+        if (d->directories.contains(directory) || !QFileInfo(directory).isDir()) continue;
+
+        d->directories.append(directory);
+        d->watcher->addPath(directory);
+        scanDirectory(directory);
+    }
+
+    //Launches are counted by LaunchStatistics now, so the old history file is no longer read
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    QFile::remove(cacheDir.absoluteFilePath("theDesk/runhistory"));
+}
+
+ExecutableIndex::~ExecutableIndex() {
+    delete d;
+}
+
+QStringList ExecutableIndex::complete(QString prefix, int limit) {
+    if (prefix.isEmpty()) return QStringList();
+
+    QStringList candidates;
+    QSet<QString> seen;
+    for (QString directory : d->directories) {
+        for (QString executable : d->executables.value(directory)) {
+            if (!executable.startsWith(prefix) || seen.contains(executable)) continue;
+            seen.insert(executable);
+            candidates.append(executable);
+        }
+    }
+
+    //Things the user runs often come first, then shorter names since they're the closest match
+    QHash<QString, double> scores;
+    for (QString candidate : qAsConst(candidates)) {
+        scores.insert(candidate, StateManager::launchStatistics()->score(candidate));
+    }
+    std::sort(candidates.begin(), candidates.end(), [ = ](QString first, QString second) {
+        double firstScore = scores.value(first);
+        double secondScore = scores.value(second);
+        if (firstScore != secondScore) return firstScore > secondScore;
+        if (first.length() != second.length()) return first.length() < second.length();
+        return first < second;
+    });
+
+    return candidates.mid(0, limit);
+}
+
+void ExecutableIndex::scanDirectory(QString directory) {
+    //Big directories like /usr/bin take a while to list, so do it off the main thread
+    IdleWorkQueue::compute<QStringList>(this, [ = ] {
+        QStringList executables;
+        for (QFileInfo file : QDir(directory).entryInfoList(QDir::Files | QDir::Executable)) {
+            executables.append(file.fileName());
+        }
+        return executables;
+    }, [ = ](QStringList executables) {
+        d->executables.insert(directory, executables);
+    });
+}
@@ -25,47 +25,79 @@
 #include <tpopover.h>
 #include <keygrab.h>
 #include <QProcess>
+#include <QDir>
+#include <QCompleter>
+#include <QStringListModel>
 #include <terrorflash.h>
+#include <statemanager.h>
+#include <launchstatistics.h>
+#include "executableindex.h"
+
+struct RunDialogPrivate {
+    ExecutableIndex* index;
+    QCompleter* completer;
+    QStringListModel* completions;
+};
 
 RunDialog::RunDialog(QWidget* parent) :
     QWidget(parent),
     ui(new Ui::RunDialog) {
     ui->setupUi(this);
+    d = new RunDialogPrivate();
 
     ui->titleLabel->setBackButtonShown(true);
     ui->widget->setFixedWidth(SC_DPI(600));
 
+    d->index = new ExecutableIndex(this);
+
+    //The index already ranks the completions, so show them as they are
+    d->completions = new QStringListModel(this);
+    d->completer = new QCompleter(d->completions, this);
+    d->completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    ui->lineEdit->setCompleter(d->completer);
+
     this->setFocusProxy(ui->lineEdit);
 }
 
 RunDialog::~RunDialog() {
+    delete d;
     delete ui;
 }
 
 void RunDialog::initialise() {
+    //Build the dialog once up front so it can take input as soon as the shortcut is pressed
+    TransparentDialog* dialog = new TransparentDialog();
+    dialog->setWindowFlag(Qt::FramelessWindowHint);
+    dialog->setWindowFlag(Qt::WindowStaysOnTopHint);
+    dialog->winId();
+
+    RunDialog* popoverContents = new RunDialog();
+    popoverContents->ensurePolished();
+    popoverContents->adjustSize();
+
     KeyGrab* grab = new KeyGrab(QKeySequence(Qt::AltModifier | Qt::Key_F2), "run");
     connect(grab, &KeyGrab::activated, [ = ] {
-        TransparentDialog* dialog = new TransparentDialog();
-        dialog->setWindowFlag(Qt::FramelessWindowHint);
-        dialog->setWindowFlag(Qt::WindowStaysOnTopHint);
+        if (dialog->isVisible()) return;
         dialog->showFullScreen();
 
-        QTimer::singleShot(500, [ = ] {
-            RunDialog* popoverContents = new RunDialog();
-
-            tPopover* popover = new tPopover(popoverContents);
-            popover->setPopoverSide(tPopover::Bottom);
-            popover->setPopoverWidth(popoverContents->sizeHint().height());
-            popover->setPerformBlur(false);
-            connect(popoverContents, &RunDialog::done, popover, &tPopover::dismiss);
-            connect(popover, &tPopover::dismissed, popoverContents, &RunDialog::deleteLater);
-            connect(popover, &tPopover::dismissed, [ = ] {
-                popover->deleteLater();
-                dialog->deleteLater();
-            });
-            popover->show(dialog);
-            popoverContents->setFocus();
+        tPopover* popover = new tPopover(popoverContents);
+        popover->setPopoverSide(tPopover::Bottom);
+        popover->setPopoverWidth(popoverContents->sizeHint().height());
+        popover->setPerformBlur(false);
+        QMetaObject::Connection doneConnection = connect(popoverContents, &RunDialog::done, popover, &tPopover::dismiss);
+        connect(popover, &tPopover::dismissed, [ = ] {
+            disconnect(doneConnection);
+
+            //Take the contents back from the popover so they can be shown again next time
+            popoverContents->hide();
+            popoverContents->setParent(nullptr);
+            popoverContents->reset();
+
+            popover->deleteLater();
+            dialog->hide();
         });
+        popover->show(dialog);
+        popoverContents->setFocus();
     });
 }
 
@@ -74,12 +106,38 @@ void RunDialog::on_titleLabel_backButtonClicked() {
 }
 
 void RunDialog::on_runButton_clicked() {
-    QStringList parts = ui->lineEdit->text().split(" ");
-    QString executable = parts.takeFirst();
+    //Split the command the way a shell would, so quoted arguments stay together
+    QStringList parts = QProcess::splitCommand(ui->lineEdit->text());
+    if (parts.isEmpty()) {
+        tErrorFlash::flashError(ui->lineEdit);
+        return;
+    }
 
+    for (QString& part : parts) {
+        if (part == "~" || part.startsWith("~/")) part.replace(0, 1, QDir::homePath());
+    }
+
+    QString executable = parts.takeFirst();
     if (QProcess::startDetached(executable, parts)) {
+        StateManager::launchStatistics()->recordLaunch(executable);
         emit done();
     } else {
         tErrorFlash::flashError(ui->lineEdit);
     }
 }
+
+void RunDialog::on_lineEdit_textEdited(const QString& text) {
+    //Only the executable is completed; arguments are left to the user
+    if (text.contains(" ")) {
+        d->completions->setStringList(QStringList());
+        return;
+    }
+
+    d->completions->setStringList(d->index->complete(text));
+    if (d->completions->rowCount() > 0) d->completer->complete();
+}
+
+void RunDialog::reset() {
+    ui->lineEdit->clear();
+    d->completions->setStringList(QStringList());
+}
@@ -26,6 +26,7 @@ namespace Ui {
     class RunDialog;
 }
 
+struct RunDialogPrivate;
 class RunDialog : public QWidget {
         Q_OBJECT
 
@@ -40,11 +41,16 @@ class RunDialog : public QWidget {
 
         void on_runButton_clicked();
 
+        void on_lineEdit_textEdited(const QString& text);
+
     signals:
         void done();
 
     private:
         Ui::RunDialog* ui;
+        RunDialogPrivate* d;
+
+        void reset();
 };
 
 #endif // RUNDIALOG_H
@@ -0,0 +1,175 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "firstframecache.h"
+
+#include <QApplication>
+#include <QScreen>
+#include <QPainter>
+#include <QTimer>
+#include <QMap>
+#include <QIcon>
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <Wm/desktopwm.h>
+
+class FirstFramePlaceholder : public QWidget {
+    public:
+        explicit FirstFramePlaceholder(QPixmap snapshot) : QWidget(nullptr) {
+            this->snapshot = snapshot;
+            this->setWindowFlag(Qt::FramelessWindowHint);
+            this->setAttribute(Qt::WA_ShowWithoutActivating);
+            this->setAttribute(Qt::WA_TranslucentBackground);
+        }
+
+    private:
+        QPixmap snapshot;
+
+        void paintEvent(QPaintEvent* event) {
+            QPainter painter(this);
+            painter.drawPixmap(this->rect(), snapshot);
+        }
+};
+
+struct FirstFrameCachePrivate {
+    FirstFrameCache* instance = nullptr;
+
+    QMap<QString, QWidget*> placeholders;
+
+    static const qint64 maximumAge = 14 * 24 * 60 * 60;
+};
+
+FirstFrameCachePrivate* FirstFrameCache::d = new FirstFrameCachePrivate();
+
+FirstFrameCache* FirstFrameCache::instance() {
+    if (!d->instance) d->instance = new FirstFrameCache();
+    return d->instance;
+}
+
+bool FirstFrameCache::showPlaceholders() {
+    bool haveAllBackgrounds = true;
+    for (QScreen* screen : QApplication::screens()) {
+        QPixmap background = snapshot("background", screen);
+        if (background.isNull()) {
+            haveAllBackgrounds = false;
+            continue;
+        }
+
+        FirstFramePlaceholder* placeholder = new FirstFramePlaceholder(background);
+        placeholder->setWindowFlag(Qt::WindowStaysOnBottomHint);
+        placeholder->setGeometry(screen->geometry());
+        DesktopWm::setSystemWindow(placeholder, DesktopWm::SystemWindowTypeDesktop);
+        placeholder->show();
+        d->placeholders.insert(snapshotPath("background", screen), placeholder);
+    }
+
+    //Without a background behind it the bar would float over the splash, so don't bother
+    QScreen* primaryScreen = QApplication::primaryScreen();
+    QPixmap bar = snapshot("bar", primaryScreen);
+    if (haveAllBackgrounds && !bar.isNull()) {
+        FirstFramePlaceholder* placeholder = new FirstFramePlaceholder(bar);
+        placeholder->setGeometry(QRect(primaryScreen->geometry().topLeft(), bar.size() / bar.devicePixelRatio()));
+        DesktopWm::setSystemWindow(placeholder, DesktopWm::SystemWindowTypeTaskbar);
+        placeholder->show();
+        d->placeholders.insert(snapshotPath("bar", primaryScreen), placeholder);
+    }
+
+    //The event loop isn't running yet, so paint the placeholders now before plugins start loading
+    if (!d->placeholders.isEmpty()) QApplication::processEvents();
+
+    return haveAllBackgrounds && !d->placeholders.isEmpty();
+}
+
+void FirstFrameCache::dismissPlaceholder(QString name, QScreen* screen) {
+    QWidget* placeholder = d->placeholders.take(snapshotPath(name, screen));
+    if (!placeholder) return;
+
+    //Give the live window a chance to paint before revealing it
+    QTimer::singleShot(100, placeholder, [ = ] {
+        placeholder->hide();
+        placeholder->deleteLater();
+    });
+}
+
+QPixmap FirstFrameCache::snapshot(QString name, QScreen* screen) {
+    QString path = snapshotPath(name, screen);
+    QImage image(path);
+    if (image.isNull()) return QPixmap();
+
+    //Backgrounds cover the whole screen; the bar spans the width of the primary screen
+    QSize expectedSize = screen->geometry().size() * screen->devicePixelRatio();
+    if (name != "background") expectedSize.setHeight(image.height());
+    if (!isSnapshotValid(QFileInfo(path), image.size(), expectedSize)) return QPixmap();
+
+    QPixmap px = QPixmap::fromImage(image);
+    px.setDevicePixelRatio(screen->devicePixelRatio());
+    return px;
+}
+
+void FirstFrameCache::saveSnapshot(QString name, QScreen* screen, QPixmap snapshot) {
+    if (snapshot.isNull()) return;
+
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    cacheDir.mkpath("theDesk/firstframe");
+
+    //Scale to device pixels so the snapshot can be checked against the screen on the next login
+    QSize size = screen->geometry().size() * screen->devicePixelRatio();
+    if (name != "background") size.setHeight(snapshot.height() * size.width() / snapshot.width());
+    snapshot.toImage().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation).save(snapshotPath(name, screen), "PNG");
+}
+
+QString FirstFrameCache::snapshotKey(QScreen* screen) {
+    //Anything that changes how the shell looks before plugins load invalidates the snapshot
+    QPalette pal = QApplication::palette();
+    QRect geometry = screen->geometry();
+    return QStringList({
+        screen->name(),
+        QStringLiteral("%1x%2+%3+%4").arg(geometry.width()).arg(geometry.height()).arg(geometry.x()).arg(geometry.y()),
+        QString::number(screen->devicePixelRatio()),
+        QIcon::themeName(),
+        pal.color(QPalette::Window).name(QColor::HexArgb),
+        pal.color(QPalette::Highlight).name(QColor::HexArgb)
+    }).join(";");
+}
+
+bool FirstFrameCache::isSnapshotValid(QFileInfo snapshotFile, QSize snapshotSize, QSize expectedSize) {
+    if (!snapshotFile.exists() || snapshotFile.size() == 0) return false;
+
+    //The screen has been resized or rescaled since the snapshot was taken
+    if (!expectedSize.isValid() || snapshotSize != expectedSize) return false;
+
+    //Stale snapshots probably don't reflect what the user will see any more
+    qint64 age = snapshotFile.lastModified().secsTo(QDateTime::currentDateTime());
+    if (age < 0 || age > FirstFrameCachePrivate::maximumAge) return false;
+
+    return true;
+}
+
+FirstFrameCache::FirstFrameCache(QObject* parent) : QObject(parent) {
+
+}
+
+QString FirstFrameCache::snapshotPath(QString name, QScreen* screen) {
+    QString hash = QCryptographicHash::hash(snapshotKey(screen).toUtf8(), QCryptographicHash::Sha1).toHex();
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    return cacheDir.absoluteFilePath(QStringLiteral("theDesk/firstframe/%1-%2.png").arg(name, hash));
+}
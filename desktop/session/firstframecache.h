@@ -0,0 +1,50 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef FIRSTFRAMECACHE_H
+#define FIRSTFRAMECACHE_H
+
+#include <QObject>
+#include <QPixmap>
+
+class QScreen;
+class QFileInfo;
+struct FirstFrameCachePrivate;
+class FirstFrameCache : public QObject {
+        Q_OBJECT
+    public:
+        static FirstFrameCache* instance();
+
+        bool showPlaceholders();
+        void dismissPlaceholder(QString name, QScreen* screen);
+
+        QPixmap snapshot(QString name, QScreen* screen);
+        void saveSnapshot(QString name, QScreen* screen, QPixmap snapshot);
+
+        static QString snapshotKey(QScreen* screen);
+        static bool isSnapshotValid(QFileInfo snapshotFile, QSize snapshotSize, QSize expectedSize);
+
+    private:
+        explicit FirstFrameCache(QObject* parent = nullptr);
+        static FirstFrameCachePrivate* d;
+
+        QString snapshotPath(QString name, QScreen* screen);
+};
+
+#endif // FIRSTFRAMECACHE_H
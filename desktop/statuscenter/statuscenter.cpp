@@ -28,6 +28,7 @@
 #include <tpopover.h>
 #include <QShortcut>
 #include <tsettings.h>
+#include <server/sessionserver.h>
 #include "statuscenterleftpane.h"
 #include "common/common.h"
 #include "systemsettings/systemsettings.h"
@@ -48,6 +49,8 @@ struct StatusCenterPrivate {
     QStringList preferredPaneOrder;
     QStringList preferredSwitchOrder;
 
+    QString restoredPane;
+
     tSettings settings;
 };
 
@@ -66,6 +69,9 @@ StatusCenter::StatusCenter(QWidget* parent) :
     d->preferredPaneOrder.removeAll("SystemSettings");
     d->preferredPaneOrder.append("SystemSettings");
 
+    //Reopen the pane the user was looking at before the shell was restarted
+    if (SessionServer::instance()->isHotRestart()) d->restoredPane = SessionServer::instance()->restoredState("statusCenterPane").toString();
+
     d->leftPane = new StatusCenterLeftPane(this);
 
     if (this->width() <= SC_DPI(1024)) {
@@ -82,6 +88,13 @@ StatusCenter::StatusCenter(QWidget* parent) :
         }
     });
     connect(StateManager::statusCenterManager(), &StatusCenterManager::paneRemoved, this, &StatusCenter::removePane);
+    connect(StateManager::statusCenterManager(), &StatusCenterManager::paneRequested, this, [ = ](StatusCenterPane * pane) {
+        if (!d->paneItems.contains(pane)) return;
+
+        QListWidgetItem* item = d->paneItems.value(pane);
+        item->listWidget()->setCurrentItem(item);
+        ui->stackedWidget->setCurrentWidget(pane);
+    });
     connect(StateManager::statusCenterManager(), &StatusCenterManager::showHamburgerMenu, this, &StatusCenter::showHamburgerMenu);
     connect(StateManager::statusCenterManager(), &StatusCenterManager::rootMenu, d->leftPane, &StatusCenterLeftPane::popMenu);
     connect(StateManager::statusCenterManager(), &StatusCenterManager::switchAdded, this, &StatusCenter::addSwitch);
@@ -152,8 +165,11 @@ void StatusCenter::showHamburgerMenu() {
 }
 
 void StatusCenter::selectPane(int index) {
+    if (index < 0 || index >= d->loadedPanes.count()) return;
+
     StatusCenterPane* pane = d->loadedPanes.at(index).second;
     ui->stackedWidget->setCurrentWidget(pane);
+    SessionServer::instance()->setRestorableState("statusCenterPane", pane->name());
 }
 
 void StatusCenter::enterMenu(int index) {
@@ -201,6 +217,12 @@ void StatusCenter::addPane(StatusCenterPane* pane) {
         d->leftPane->insertItem(index, item);
         d->loadedPanes.insert(index, {pane->name(), pane});
     }
+
+    if (!d->restoredPane.isEmpty() && d->restoredPane == pane->name()) {
+        d->restoredPane.clear();
+        item->listWidget()->setCurrentItem(item);
+        ui->stackedWidget->setCurrentWidget(pane);
+    }
 }
 
 void StatusCenter::removePane(StatusCenterPane* pane) {
@@ -63,6 +63,16 @@ SystemSettings::SystemSettings(StatusCenterLeftPane* leftPane) :
         }
     });
     connect(StateManager::statusCenterManager(), &StatusCenterManager::paneRemoved, this, &SystemSettings::removePane);
+    connect(StateManager::statusCenterManager(), &StatusCenterManager::paneRequested, this, [ = ](StatusCenterPane * pane) {
+        if (!d->paneItems.contains(pane)) return;
+
+        QListWidgetItem* item = d->paneItems.value(pane);
+        item->listWidget()->setCurrentItem(item);
+        ui->stackedWidget->setCurrentWidget(pane);
+
+        //Bring System Settings itself to the front of the Status Center
+        StateManager::statusCenterManager()->showPane(this);
+    });
 
     for (StatusCenterPane* pane : StateManager::statusCenterManager()->panes()) {
         if (StateManager::statusCenterManager()->paneType(pane) == StatusCenterManager::SystemSettings) this->addPane(pane);
@@ -0,0 +1,119 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "animationclock.h"
+
+#include <QAbstractAnimation>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QSet>
+
+struct AnimationClockFrameWork {
+    QPointer<QObject> context;
+    std::function<void()> work;
+};
+
+struct AnimationClockPrivate {
+    QSet<QAbstractAnimation*> runningAnimations;
+
+    QList<QPair<QObject*, QString>> workOrder;
+    QHash<QPair<QObject*, QString>, AnimationClockFrameWork> work;
+    bool flushPending = false;
+
+    QElapsedTimer frameTimer;
+    qint64 lastFrameInterval = 0;
+    qint64 lastFrameDuration = 0;
+};
+
+AnimationClock::AnimationClock(QObject* parent) : QObject(parent) {
+    d = new AnimationClockPrivate();
+}
+
+AnimationClock::~AnimationClock() {
+    delete d;
+}
+
+void AnimationClock::registerAnimation(QAbstractAnimation* animation) {
+    connect(animation, &QAbstractAnimation::stateChanged, this, [ = ](QAbstractAnimation::State newState) {
+        bool wasAnimating = isAnimating();
+        if (newState == QAbstractAnimation::Running) {
+            d->runningAnimations.insert(animation);
+        } else {
+            d->runningAnimations.remove(animation);
+        }
+
+        if (wasAnimating != isAnimating()) {
+            if (isAnimating()) d->frameTimer.invalidate();
+            emit animatingChanged(isAnimating());
+        }
+    });
+    connect(animation, &QAbstractAnimation::destroyed, this, [ = ] {
+        bool wasAnimating = isAnimating();
+        d->runningAnimations.remove(animation);
+        if (wasAnimating != isAnimating()) emit animatingChanged(false);
+    });
+
+    if (animation->state() == QAbstractAnimation::Running) d->runningAnimations.insert(animation);
+}
+
+bool AnimationClock::isAnimating() {
+    return !d->runningAnimations.isEmpty();
+}
+
+void AnimationClock::scheduleFrameWork(QObject* context, QString key, std::function<void()> work) {
+    QPair<QObject*, QString> workKey(context, key);
+    if (!d->work.contains(workKey)) d->workOrder.append(workKey);
+    d->work.insert(workKey, {context, work});
+
+    //All animations are stepped by the same timer event, so this runs after every animation has updated for this frame
+    if (!d->flushPending) {
+        d->flushPending = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+}
+
+qint64 AnimationClock::lastFrameInterval() {
+    return d->lastFrameInterval;
+}
+
+qint64 AnimationClock::lastFrameDuration() {
+    return d->lastFrameDuration;
+}
+
+void AnimationClock::flush() {
+    d->flushPending = false;
+
+    d->lastFrameInterval = d->frameTimer.isValid() ? d->frameTimer.nsecsElapsed() : 0;
+    d->frameTimer.start();
+
+    QList<QPair<QObject*, QString>> workOrder = d->workOrder;
+    QHash<QPair<QObject*, QString>, AnimationClockFrameWork> work = d->work;
+    d->workOrder.clear();
+    d->work.clear();
+
+    QElapsedTimer durationTimer;
+    durationTimer.start();
+    for (const QPair<QObject*, QString>& key : workOrder) {
+        AnimationClockFrameWork item = work.value(key);
+        if (item.context) item.work();
+    }
+    d->lastFrameDuration = durationTimer.nsecsElapsed();
+
+    emit frameFinished(d->lastFrameInterval, d->lastFrameDuration);
+}
@@ -0,0 +1,54 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef ANIMATIONCLOCK_H
+#define ANIMATIONCLOCK_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <functional>
+
+class QAbstractAnimation;
+struct AnimationClockPrivate;
+class LIBTHEDESK_EXPORT AnimationClock : public QObject {
+        Q_OBJECT
+    public:
+        explicit AnimationClock(QObject* parent = nullptr);
+        ~AnimationClock();
+
+        void registerAnimation(QAbstractAnimation* animation);
+        bool isAnimating();
+
+        //Runs work once at the end of the current frame. Work scheduled again for the same context and key replaces the old work.
+        void scheduleFrameWork(QObject* context, QString key, std::function<void()> work);
+
+        qint64 lastFrameInterval();
+        qint64 lastFrameDuration();
+
+    signals:
+        void animatingChanged(bool isAnimating);
+        void frameFinished(qint64 interval, qint64 duration);
+
+    private:
+        AnimationClockPrivate* d;
+
+        Q_INVOKABLE void flush();
+};
+
+#endif // ANIMATIONCLOCK_H
@@ -22,15 +22,25 @@
 #include <statemanager.h>
 #include <barmanager.h>
 #include <QMouseEvent>
+#include <QTimer>
 #include "private/quickwidgetcontainer.h"
 
+//How long a quick widget container stays around after it is closed
+#define QUICK_WIDGET_CONTAINER_RELEASE_TIMEOUT 60000
+
 struct ChunkPrivate {
-    QuickWidgetContainer* quickWidgetContainer;
+    QuickWidgetContainer* quickWidgetContainer = nullptr;
+    QTimer* releaseTimer;
 };
 
 Chunk::Chunk() : QWidget(nullptr) {
     d = new ChunkPrivate();
-    d->quickWidgetContainer = new QuickWidgetContainer(this);
+
+    //The quick widget container is a top level window, so only create it when it is first opened
+    d->releaseTimer = new QTimer(this);
+    d->releaseTimer->setSingleShot(true);
+    d->releaseTimer->setInterval(QUICK_WIDGET_CONTAINER_RELEASE_TIMEOUT);
+    connect(d->releaseTimer, &QTimer::timeout, this, &Chunk::releaseQuickWidgetContainer);
 }
 
 Chunk::~Chunk() {
@@ -48,13 +58,33 @@ void Chunk::performStatusBarTransition(qreal percentage) {
 
 void Chunk::showQuickWidget() {
     if (quickWidget()) {
+        d->releaseTimer->stop();
+        if (!d->quickWidgetContainer) {
+            d->quickWidgetContainer = new QuickWidgetContainer(this);
+            connect(d->quickWidgetContainer, &QuickWidgetContainer::containerHidden, d->releaseTimer, QOverload<>::of(&QTimer::start));
+        }
+
         //Show the quick widget
         d->quickWidgetContainer->showContainer();
     }
 }
 
 void Chunk::hideQuickWidget() {
-    d->quickWidgetContainer->hideContainer();
+    if (d->quickWidgetContainer) d->quickWidgetContainer->hideContainer();
+}
+
+void Chunk::releaseQuickWidgetContainer() {
+    if (!d->quickWidgetContainer || d->quickWidgetContainer->isVisible()) return;
+
+    //The quick widget belongs to the chunk, so take it back before the container goes away
+    QWidget* widget = quickWidget();
+    if (widget) {
+        widget->hide();
+        widget->setParent(this);
+    }
+
+    d->quickWidgetContainer->deleteLater();
+    d->quickWidgetContainer = nullptr;
 }
 
 void Chunk::mousePressEvent(QMouseEvent* event) {
@@ -53,6 +53,8 @@ class Chunk : public QWidget {
     private:
         ChunkPrivate* d;
 
+        void releaseQuickWidgetContainer();
+
         void mousePressEvent(QMouseEvent* event);
         void mouseReleaseEvent(QMouseEvent* event);
 };
@@ -19,8 +19,11 @@
  * *************************************/
 #include "gatewaymanager.h"
 
+#include "searchprovider.h"
+
 struct GatewayManagerPrivate {
     int gatewayWidth = 0;
+    QList<SearchProvider*> searchProviders;
 };
 
 GatewayManager::GatewayManager(QObject* parent) : QObject(parent) {
@@ -39,3 +42,22 @@ void GatewayManager::setGatewayWidth(int width) {
     d->gatewayWidth = width;
     emit gatewayWidthChanged(width);
 }
+
+void GatewayManager::addSearchProvider(SearchProvider* provider) {
+    if (d->searchProviders.contains(provider)) return;
+    d->searchProviders.append(provider);
+    connect(provider, &SearchProvider::destroyed, this, [ = ] {
+        removeSearchProvider(provider);
+    });
+    emit searchProviderAdded(provider);
+}
+
+void GatewayManager::removeSearchProvider(SearchProvider* provider) {
+    if (!d->searchProviders.removeOne(provider)) return;
+    disconnect(provider, nullptr, this, nullptr);
+    emit searchProviderRemoved(provider);
+}
+
+QList<SearchProvider*> GatewayManager::searchProviders() {
+    return d->searchProviders;
+}
@@ -23,6 +23,7 @@
 #include <QObject>
 
 class Gateway;
+class SearchProvider;
 struct GatewayManagerPrivate;
 class GatewayManager : public QObject {
         Q_OBJECT
@@ -32,8 +33,14 @@ class GatewayManager : public QObject {
 
         int gatewayWidth();
 
+        void addSearchProvider(SearchProvider* provider);
+        void removeSearchProvider(SearchProvider* provider);
+        QList<SearchProvider*> searchProviders();
+
     signals:
         void gatewayWidthChanged(int width);
+        void searchProviderAdded(SearchProvider* provider);
+        void searchProviderRemoved(SearchProvider* provider);
 
     protected:
         friend Gateway;
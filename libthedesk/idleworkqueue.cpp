@@ -0,0 +1,170 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "idleworkqueue.h"
+
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QPointer>
+#include <QTimer>
+#include <Wm/desktopwm.h>
+
+//Time spent running tasks before returning to the event loop
+#define IDLE_WORK_QUEUE_SLICE 4
+
+//How long the user needs to be away before low priority tasks run
+#define IDLE_WORK_QUEUE_USER_IDLE 2000
+
+struct IdleWorkQueueTask {
+    QPointer<QObject> context;
+    std::function<void()> task;
+    IdleWorkQueue::Priority priority;
+    qint64 deadline;
+};
+
+struct IdleWorkQueuePrivate {
+    QList<IdleWorkQueueTask> tasks;
+
+    QElapsedTimer clock;
+    QTimer* sliceTimer;
+    QTimer* deadlineTimer;
+    QTimer* userIdleTimer;
+};
+
+IdleWorkQueue::IdleWorkQueue(QObject* parent) : QObject(parent) {
+    d = new IdleWorkQueuePrivate();
+    d->clock.start();
+
+    d->sliceTimer = new QTimer(this);
+    d->sliceTimer->setSingleShot(true);
+    d->sliceTimer->setInterval(0);
+    connect(d->sliceTimer, &QTimer::timeout, this, &IdleWorkQueue::runSlice);
+
+    d->deadlineTimer = new QTimer(this);
+    d->deadlineTimer->setSingleShot(true);
+    connect(d->deadlineTimer, &QTimer::timeout, this, &IdleWorkQueue::runSlice);
+
+    d->userIdleTimer = new QTimer(this);
+    d->userIdleTimer->setSingleShot(true);
+    connect(d->userIdleTimer, &QTimer::timeout, this, &IdleWorkQueue::scheduleSlice);
+
+    //The event loop is idle when it is about to go to sleep
+    connect(QAbstractEventDispatcher::instance(), &QAbstractEventDispatcher::aboutToBlock, this, &IdleWorkQueue::scheduleSlice);
+}
+
+IdleWorkQueue::~IdleWorkQueue() {
+    delete d;
+}
+
+void IdleWorkQueue::enqueue(QObject* context, std::function<void()> task, Priority priority, int deadline) {
+    IdleWorkQueueTask item;
+    item.context = context;
+    item.task = task;
+    item.priority = priority;
+    item.deadline = deadline < 0 ? -1 : d->clock.elapsed() + deadline;
+
+    //Keep the queue ordered by priority, and by insertion order within a priority
+    int index = 0;
+    while (index < d->tasks.count() && d->tasks.at(index).priority >= priority) index++;
+    d->tasks.insert(index, item);
+
+    updateDeadlineTimer();
+}
+
+int IdleWorkQueue::pendingTasks() {
+    return d->tasks.count();
+}
+
+void IdleWorkQueue::runOnThreadPool(QObject* context, std::function<void()> work, std::function<void()> done) {
+    QFutureWatcher<void>* watcher = new QFutureWatcher<void>(context);
+    connect(watcher, &QFutureWatcher<void>::finished, context, [ = ] {
+        done();
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(work));
+}
+
+void IdleWorkQueue::scheduleSlice() {
+    if (d->tasks.isEmpty() || d->sliceTimer->isActive()) return;
+
+    //Only low priority tasks are waiting for the user to go idle; anything more important still runs
+    if (d->userIdleTimer->isActive() && d->tasks.first().priority == Low) return;
+    d->sliceTimer->start();
+}
+
+void IdleWorkQueue::runSlice() {
+    QElapsedTimer slice;
+    slice.start();
+
+    qint64 now = d->clock.elapsed();
+    bool checkedUserIdle = false;
+    bool userIdle = false;
+    bool skippedLow = false;
+
+    for (int i = 0; i < d->tasks.count() && slice.elapsed() < IDLE_WORK_QUEUE_SLICE;) {
+        IdleWorkQueueTask task = d->tasks.at(i);
+        if (!task.context) {
+            d->tasks.removeAt(i);
+            continue;
+        }
+
+        bool overdue = task.deadline != -1 && task.deadline <= now;
+        if (task.priority == Low && !overdue) {
+            if (!checkedUserIdle) {
+                userIdle = DesktopWm::msecsIdle() >= IDLE_WORK_QUEUE_USER_IDLE;
+                checkedUserIdle = true;
+            }
+
+            if (!userIdle) {
+                //Keep looking; an overdue low priority task further along still needs to run
+                skippedLow = true;
+                i++;
+                continue;
+            }
+        }
+
+        d->tasks.removeAt(i);
+        task.task();
+    }
+
+    if (skippedLow) {
+        //Low priority tasks are waiting and the user is busy; check back later instead of spinning
+        d->userIdleTimer->start(IDLE_WORK_QUEUE_USER_IDLE);
+    }
+
+    updateDeadlineTimer();
+}
+
+void IdleWorkQueue::updateDeadlineTimer() {
+    qint64 nextDeadline = -1;
+    for (const IdleWorkQueueTask& task : d->tasks) {
+        //Tasks whose context is gone will never run, so they shouldn't wake the queue
+        if (!task.context) continue;
+        if (task.deadline != -1 && (nextDeadline == -1 || task.deadline < nextDeadline)) nextDeadline = task.deadline;
+    }
+
+    if (nextDeadline == -1) {
+        d->deadlineTimer->stop();
+    } else {
+        d->deadlineTimer->start(qMax<qint64>(0, nextDeadline - d->clock.elapsed()));
+    }
+}
@@ -0,0 +1,65 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef IDLEWORKQUEUE_H
+#define IDLEWORKQUEUE_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <QSharedPointer>
+#include <functional>
+
+struct IdleWorkQueuePrivate;
+class LIBTHEDESK_EXPORT IdleWorkQueue : public QObject {
+        Q_OBJECT
+    public:
+        explicit IdleWorkQueue(QObject* parent = nullptr);
+        ~IdleWorkQueue();
+
+        enum Priority {
+            Low, //Only runs while the user is not using the computer
+            Normal,
+            High
+        };
+
+        //Runs task on the main thread in a time slice when the event loop is idle. If deadline (in ms) passes, the task runs regardless.
+        void enqueue(QObject* context, std::function<void()> task, Priority priority = Normal, int deadline = -1);
+        int pendingTasks();
+
+        //Runs computation on the thread pool and hands the result to callback on the main thread, as long as context still exists
+        template<typename T> static void compute(QObject* context, std::function<T()> computation, std::function<void(T)> callback) {
+            QSharedPointer<T> result(new T());
+            runOnThreadPool(context, [ = ] {
+                *result = computation();
+            }, [ = ] {
+                callback(*result);
+            });
+        }
+
+    private:
+        IdleWorkQueuePrivate* d;
+
+        static void runOnThreadPool(QObject* context, std::function<void()> work, std::function<void()> done);
+
+        void scheduleSlice();
+        void runSlice();
+        void updateDeadlineTimer();
+};
+
+#endif // IDLEWORKQUEUE_H
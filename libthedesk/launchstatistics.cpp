@@ -0,0 +1,298 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "launchstatistics.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtMath>
+#include <QTimer>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QRegularExpression>
+#include <QDBusMessage>
+#include <QDBusVariant>
+#include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QLibraryInfo>
+#include <QLoggingCategory>
+#include <elf.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "statemanager.h"
+#include "idleworkqueue.h"
+
+Q_LOGGING_CATEGORY(readaheadLog, "thedesk.readahead", QtInfoMsg)
+
+//How long to wait after login before warming the page cache
+#define LAUNCH_STATISTICS_READAHEAD_DELAY 60000
+
+//Longest wait between attempts when the system is on battery or the disk is busy
+#define LAUNCH_STATISTICS_READAHEAD_MAX_BACKOFF 3600000
+
+//Number of applications to warm up
+#define LAUNCH_STATISTICS_READAHEAD_COUNT 5
+
+//Stop warming once this many bytes have been read
+#define LAUNCH_STATISTICS_READAHEAD_BUDGET (256 * 1024 * 1024)
+
+struct LaunchStatisticsPrivate {
+    QJsonObject launches;
+    bool readingAhead = false;
+    int readaheadBackoff = LAUNCH_STATISTICS_READAHEAD_DELAY;
+};
+
+struct LaunchStatisticsReadahead {
+    qint64 bytes = 0;
+    bool interrupted = false;
+};
+
+LaunchStatistics::LaunchStatistics(QObject* parent) : QObject(parent) {
+    d = new LaunchStatisticsPrivate();
+
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    QFile file(cacheDir.absoluteFilePath("theDesk/launches.json"));
+    if (file.open(QFile::ReadOnly)) d->launches = QJsonDocument::fromJson(file.readAll()).object();
+
+    //Once the session has settled down, warm up the apps the user is likely to open while they're not using the computer
+    scheduleReadahead(LAUNCH_STATISTICS_READAHEAD_DELAY);
+}
+
+LaunchStatistics::~LaunchStatistics() {
+    delete d;
+}
+
+void LaunchStatistics::recordLaunch(QString executable) {
+    if (executable.isEmpty()) return;
+
+    QJsonObject entry = d->launches.value(executable).toObject();
+    entry.insert("count", entry.value("count").toInt() + 1);
+    entry.insert("last", QDateTime::currentSecsSinceEpoch());
+    d->launches.insert(executable, entry);
+    save();
+}
+
+double LaunchStatistics::score(QString executable) {
+    if (!d->launches.contains(executable)) return 0;
+
+    //Launch counts fade by half every week so old favourites make way for what's being used now
+    QJsonObject entry = d->launches.value(executable).toObject();
+    double weeks = (QDateTime::currentSecsSinceEpoch() - entry.value("last").toVariant().toLongLong()) / 604800.0;
+    return entry.value("count").toInt() * qPow(0.5, weeks);
+}
+
+QStringList LaunchStatistics::topExecutables(int count) {
+    QList<QPair<double, QString>> scores;
+    for (QString executable : d->launches.keys()) {
+        scores.append({score(executable), executable});
+    }
+
+    std::sort(scores.begin(), scores.end(), [ = ](QPair<double, QString> first, QPair<double, QString> second) {
+        return first.first > second.first;
+    });
+
+    QStringList executables;
+    for (QPair<double, QString> score : scores.mid(0, count)) {
+        executables.append(score.second);
+    }
+    return executables;
+}
+
+void LaunchStatistics::readahead() {
+    if (d->readingAhead) return;
+    d->readingAhead = true;
+
+    //Spinning up the disk costs battery. Ask UPower without blocking, since it may not be running at all.
+    QDBusMessage onBatteryMessage = QDBusMessage::createMethodCall("org.freedesktop.UPower", "/org/freedesktop/UPower", "org.freedesktop.DBus.Properties", "Get");
+    onBatteryMessage.setArguments({"org.freedesktop.UPower", "OnBattery"});
+
+    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(onBatteryMessage), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        watcher->deleteLater();
+
+        bool onBattery = !watcher->isError() && watcher->reply().arguments().value(0).value<QDBusVariant>().variant().toBool();
+        if (onBattery || isDiskBusy()) {
+            retryReadahead();
+            return;
+        }
+
+        readFiles();
+    });
+}
+
+void LaunchStatistics::scheduleReadahead(int delay) {
+    QTimer::singleShot(delay, this, [ = ] {
+        StateManager::idleWorkQueue()->enqueue(this, [ = ] {
+            this->readahead();
+        }, IdleWorkQueue::Low);
+    });
+}
+
+void LaunchStatistics::retryReadahead() {
+    //Try again later rather than giving up for the whole session
+    d->readingAhead = false;
+    d->readaheadBackoff = qMin(d->readaheadBackoff * 2, LAUNCH_STATISTICS_READAHEAD_MAX_BACKOFF);
+    qCDebug(readaheadLog) << "Postponing read ahead for" << d->readaheadBackoff << "ms";
+    scheduleReadahead(d->readaheadBackoff);
+}
+
+void LaunchStatistics::readFiles() {
+    QStringList files;
+    for (QString executable : topExecutables(LAUNCH_STATISTICS_READAHEAD_COUNT)) {
+        QString path = QStandardPaths::findExecutable(executable);
+        if (path.isEmpty()) continue;
+        files.append(path);
+    }
+
+    IdleWorkQueue::compute<LaunchStatisticsReadahead>(this, [ = ] {
+        QStringList toRead;
+        for (QString file : files) {
+            toRead.append(file);
+            for (QString library : sharedLibraries(file)) {
+                if (!toRead.contains(library)) toRead.append(library);
+            }
+        }
+
+        LaunchStatisticsReadahead result;
+        for (QString file : toRead) {
+            if (result.bytes > LAUNCH_STATISTICS_READAHEAD_BUDGET) break;
+
+            //Back off as soon as the disk gets busy; we don't want to get in the way of the user
+            if (isDiskBusy()) {
+                result.interrupted = true;
+                break;
+            }
+
+            int fd = open(QFile::encodeName(file).constData(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;
+
+            off_t size = lseek(fd, 0, SEEK_END);
+            if (size > 0) {
+                posix_fadvise(fd, 0, size, POSIX_FADV_WILLNEED);
+                result.bytes += size;
+            }
+            close(fd);
+        }
+        return result;
+    }, [ = ](LaunchStatisticsReadahead result) {
+        qCDebug(readaheadLog) << "Read ahead" << result.bytes << "bytes for frequently launched applications";
+        if (result.interrupted) {
+            retryReadahead();
+        } else {
+            d->readingAhead = false;
+        }
+    });
+}
+
+void LaunchStatistics::save() {
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    cacheDir.mkpath("theDesk");
+
+    QFile file(cacheDir.absoluteFilePath("theDesk/launches.json"));
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) return;
+    file.write(QJsonDocument(d->launches).toJson(QJsonDocument::Compact));
+}
+
+bool LaunchStatistics::isDiskBusy() {
+    QFile pressure("/proc/pressure/io");
+    if (pressure.open(QFile::ReadOnly)) {
+        QRegularExpressionMatch match = QRegularExpression("some avg10=([0-9.]+)").match(pressure.readAll());
+        if (match.hasMatch() && match.captured(1).toDouble() > 5) return true;
+    }
+    return false;
+}
+
+QStringList LaunchStatistics::sharedLibraries(QString executable) {
+    QStringList searchPaths = {
+        QLibraryInfo::location(QLibraryInfo::LibrariesPath),
+        "/usr/lib64",
+        "/lib64",
+        "/usr/lib/x86_64-linux-gnu",
+        "/lib/x86_64-linux-gnu",
+        "/usr/lib",
+        "/lib"
+    };
+
+    //Walk the DT_NEEDED entries of each ELF file, breadth first
+    QStringList libraries;
+    QStringList queue = {executable};
+    while (!queue.isEmpty() && libraries.count() < 200) {
+        QFile file(queue.takeFirst());
+        if (!file.open(QFile::ReadOnly)) continue;
+
+        qint64 size = file.size();
+        const uchar* data = file.map(0, size);
+        if (!data || size < static_cast<qint64>(sizeof(Elf64_Ehdr))) continue;
+
+        const Elf64_Ehdr* header = reinterpret_cast<const Elf64_Ehdr*>(data);
+        if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 || header->e_ident[EI_CLASS] != ELFCLASS64) continue;
+        if (header->e_phoff + header->e_phnum * sizeof(Elf64_Phdr) > static_cast<quint64>(size)) continue;
+
+        const Elf64_Phdr* programHeaders = reinterpret_cast<const Elf64_Phdr*>(data + header->e_phoff);
+        const Elf64_Phdr* dynamic = nullptr;
+        for (int i = 0; i < header->e_phnum; i++) {
+            if (programHeaders[i].p_type == PT_DYNAMIC) dynamic = &programHeaders[i];
+        }
+        if (!dynamic || dynamic->p_offset + dynamic->p_filesz > static_cast<quint64>(size)) continue;
+
+        //The string table is given as a virtual address, so map it back to a file offset
+        auto fileOffset = [ = ](quint64 address) -> qint64 {
+            for (int i = 0; i < header->e_phnum; i++) {
+                const Elf64_Phdr& segment = programHeaders[i];
+                if (segment.p_type == PT_LOAD && address >= segment.p_vaddr && address < segment.p_vaddr + segment.p_filesz) {
+                    return address - segment.p_vaddr + segment.p_offset;
+                }
+            }
+            return -1;
+        };
+
+        const Elf64_Dyn* entries = reinterpret_cast<const Elf64_Dyn*>(data + dynamic->p_offset);
+        int entryCount = dynamic->p_filesz / sizeof(Elf64_Dyn);
+        qint64 stringTable = -1;
+        for (int i = 0; i < entryCount && entries[i].d_tag != DT_NULL; i++) {
+            if (entries[i].d_tag == DT_STRTAB) stringTable = fileOffset(entries[i].d_un.d_ptr);
+        }
+        if (stringTable < 0) continue;
+
+        for (int i = 0; i < entryCount && entries[i].d_tag != DT_NULL; i++) {
+            if (entries[i].d_tag != DT_NEEDED) continue;
+
+            qint64 nameOffset = stringTable + entries[i].d_un.d_val;
+            if (nameOffset >= size) continue;
+            QString name = QString::fromLocal8Bit(reinterpret_cast<const char*>(data + nameOffset), qstrnlen(reinterpret_cast<const char*>(data + nameOffset), size - nameOffset));
+
+            for (QString searchPath : searchPaths) {
+                QString path = QDir(searchPath).absoluteFilePath(name);
+                if (QFile::exists(path)) {
+                    path = QFileInfo(path).canonicalFilePath();
+                    if (!libraries.contains(path)) {
+                        libraries.append(path);
+                        queue.append(path);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    return libraries;
+}
@@ -0,0 +1,50 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef LAUNCHSTATISTICS_H
+#define LAUNCHSTATISTICS_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+
+struct LaunchStatisticsPrivate;
+class LIBTHEDESK_EXPORT LaunchStatistics : public QObject {
+        Q_OBJECT
+    public:
+        explicit LaunchStatistics(QObject* parent = nullptr);
+        ~LaunchStatistics();
+
+        void recordLaunch(QString executable);
+        double score(QString executable);
+        QStringList topExecutables(int count);
+
+        void readahead();
+
+    private:
+        LaunchStatisticsPrivate* d;
+
+        void save();
+        void scheduleReadahead(int delay);
+        void retryReadahead();
+        void readFiles();
+        static bool isDiskBusy();
+        static QStringList sharedLibraries(QString executable);
+};
+
+#endif // LAUNCHSTATISTICS_H
@@ -1,4 +1,4 @@
-QT += widgets thelib tdesktopenvironment dbus multimedia multimediawidgets quickwidgets
+QT += widgets thelib tdesktopenvironment dbus multimedia multimediawidgets quickwidgets concurrent
 
 TEMPLATE = lib
 DEFINES += LIBTHEDESK_LIBRARY
@@ -22,15 +22,19 @@ DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs depr
 
 SOURCES += \
     actionquickwidget.cpp \
+    animationclock.cpp \
     barmanager.cpp \
     chunk.cpp \
     common.cpp \
     gatewaymanager.cpp \
     hudmanager.cpp \
     icontextchunk.cpp \
+    idleworkqueue.cpp \
     keygrab.cpp \
+    launchstatistics.cpp \
     localemanager.cpp \
     onboarding/onboarding.cpp \
+    onboarding/onboardingaudiostream.cpp \
     onboarding/onboardingbar.cpp \
     onboarding/onboardingbetathankyou.cpp \
     onboarding/onboardingcontroller.cpp \
@@ -40,30 +44,40 @@ SOURCES += \
     onboarding/onboardingwelcome.cpp \
     onboardingmanager.cpp \
     onboardingpage.cpp \
+    performancemonitor.cpp \
     plugins/pluginmanager.cpp \
     powermanager.cpp \
+    private/localelistmodel.cpp \
     private/localeselector.cpp \
     private/quickwidgetcontainer.cpp \
     quickswitch.cpp \
     quietmodemanager.cpp \
+    searchprovider.cpp \
     server/sessionserver.cpp \
+    settingbinding.cpp \
+    stallwatchdog.cpp \
     statemanager.cpp \
     statuscentermanager.cpp \
     statuscenterpane.cpp \
-    transparentdialog.cpp
+    transparentdialog.cpp \
+    windowstatemanager.cpp
 
 HEADERS += \
     actionquickwidget.h \
+    animationclock.h \
     barmanager.h \
     chunk.h \
     common.h \
     gatewaymanager.h \
     hudmanager.h \
     icontextchunk.h \
+    idleworkqueue.h \
     keygrab.h \
+    launchstatistics.h \
     libthedesk_global.h \
     localemanager.h \
     onboarding/onboarding.h \
+    onboarding/onboardingaudiostream.h \
     onboarding/onboardingbar.h \
     onboarding/onboardingbetathankyou.h \
     onboarding/onboardingcontroller.h \
@@ -73,19 +87,25 @@ HEADERS += \
     onboarding/onboardingwelcome.h \
     onboardingmanager.h \
     onboardingpage.h \
+    performancemonitor.h \
     plugins/pluginmanager.h \
     plugins/plugininterface.h \
     powermanager.h \
+    private/localelistmodel.h \
     private/localeselector.h \
     private/onboardingmanager_p.h \
     private/quickwidgetcontainer.h \
     quickswitch.h \
     quietmodemanager.h \
+    searchprovider.h \
     server/sessionserver.h \
+    settingbinding.h \
+    stallwatchdog.h \
     statemanager.h \
     statuscentermanager.h \
     statuscenterpane.h \
-    transparentdialog.h
+    transparentdialog.h \
+    windowstatemanager.h
 
 # Default rules for deployment.
 unix {
@@ -109,6 +129,8 @@ unix {
     INSTALLS += target translations headers pluginheaders onboardingheaders pluginmanagerheaders
 }
 
+LIBS += -ldl
+
 DEFINES += SYSTEM_LIBRARY_DIRECTORY=\\\"$$[QT_INSTALL_LIBS]\\\"
 
 FORMS += \
@@ -23,6 +23,10 @@
 #include <QTranslator>
 #include <QApplication>
 #include <QDir>
+#include <QFileInfo>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QCryptographicHash>
 #include "private/localeselector.h"
 #include <tpopover.h>
 #include <tpromise.h>
@@ -31,6 +35,9 @@
 struct LocaleManagerPrivate {
     QMap<int, QTranslator*> translators;
     QMap<int, QStringList> searchPaths;
+    QMap<int, QString> loadedFiles;
+
+    QSettings* catalogueCache;
 
     tSettings settings;
     QStringList preferredLocales;
@@ -42,6 +49,10 @@ struct LocaleManagerPrivate {
 LocaleManager::LocaleManager(QObject* parent) : QObject(parent) {
     d = new LocaleManagerPrivate();
 
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/theDesk";
+    QDir::root().mkpath(cacheDir);
+    d->catalogueCache = new QSettings(cacheDir + "/translations.conf", QSettings::IniFormat, this);
+
     d->preferredLocales = d->settings.delimitedList("Locale/locales");
     if (d->preferredLocales.count() == 1 && d->preferredLocales.first() == "") d->preferredLocales = QStringList({"C"});
     d->formats = d->settings.value("Locale/formats").toString();
@@ -94,6 +105,7 @@ void LocaleManager::removeTranslationSet(int translationSet) {
 
     d->translators.remove(translationSet);
     d->searchPaths.remove(translationSet);
+    d->loadedFiles.remove(translationSet);
 }
 
 QLocale LocaleManager::showLocaleSelector(QWidget* parent, bool* ok) {
@@ -198,9 +210,61 @@ QLocale LocaleManager::formatLocale() {
 void LocaleManager::updateTranslator(int id) {
     QTranslator* translator = d->translators.value(id);
     QStringList searchPaths = d->searchPaths.value(id);
+
+    //Resolving a translation probes every UI language in every search path, so remember which file each locale resolves to
+    //Key on the UI languages since those are exactly what the translator probes for
+    QString cacheKey = QCryptographicHash::hash((searchPaths.join(":") + "/" + QLocale().uiLanguages().join(",")).toUtf8(), QCryptographicHash::Sha1).toHex();
+    QString signature = translationSignature(searchPaths);
+
+    QString file;
+    bool cached = false;
+    d->catalogueCache->beginGroup(cacheKey);
+    if (d->catalogueCache->contains("file") && d->catalogueCache->value("signature").toString() == signature) {
+        file = d->catalogueCache->value("file").toString();
+        cached = file.isEmpty() || QFileInfo(file).lastModified().toMSecsSinceEpoch() == d->catalogueCache->value("modified").toLongLong();
+    }
+    d->catalogueCache->endGroup();
+
+    if (cached) {
+        //Don't bother reloading a translation that is already loaded
+        if (d->loadedFiles.contains(id) && d->loadedFiles.value(id) == file) return;
+        if (file.isEmpty()) {
+            //There is no catalogue for this locale, so get rid of the one for the previous locale
+            translator->load(QString());
+            d->loadedFiles.insert(id, file);
+            return;
+        }
+        if (translator->load(file)) {
+            d->loadedFiles.insert(id, file);
+            return;
+        }
+    }
+
+    file.clear();
+    for (QString path : searchPaths) {
+        if (translator->load(QLocale(), "", "", path, ".qm")) {
+            //Success!
+            file = translator->filePath();
+            break;
+        }
+    }
+    d->loadedFiles.insert(id, file);
+
+    d->catalogueCache->beginGroup(cacheKey);
+    d->catalogueCache->setValue("signature", signature);
+    d->catalogueCache->setValue("file", file);
+    d->catalogueCache->setValue("modified", file.isEmpty() ? 0 : QFileInfo(file).lastModified().toMSecsSinceEpoch());
+    d->catalogueCache->endGroup();
+}
+
+QString LocaleManager::translationSignature(QStringList searchPaths) {
+    //Adding or removing a translation changes the modification time of its directory
+    QStringList parts;
     for (QString path : searchPaths) {
-        if (translator->load(QLocale(), "", "", path, ".qm")) return; //Success!
+        QFileInfo info(path);
+        parts.append(QString::number(info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0));
     }
+    return parts.join(":");
 }
 
 void LocaleManager::updateLocales() {
@@ -53,6 +53,7 @@ class LocaleManager : public QObject {
         LocaleManagerPrivate* d;
 
         void updateTranslator(int id);
+        QString translationSignature(QStringList searchPaths);
         void updateLocales();
         QString glibName(QLocale locale, QString encoding = "UTF-8");
 };
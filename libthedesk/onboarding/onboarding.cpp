@@ -29,9 +29,9 @@
 #include <onboardingpage.h>
 #include "onboardingstepper.h"
 #include "onboardingbar.h"
+#include "onboardingaudiostream.h"
 #include <QPainter>
 #include <QKeyEvent>
-#include <QAudioDecoder>
 #include <QAudioOutput>
 
 #include <QMediaPlayer>
@@ -47,12 +47,10 @@ struct OnboardingPrivate {
 
 //    QMediaPlayer* audioPlayer = nullptr;
 //    QMediaPlaylist* audioPlaylist;
-    QByteArray singleAudioData;
-    QByteArray loopAudioData;
+    OnboardingAudioStream* audioStream = nullptr;
     QAudioOutput* audioOutput = nullptr;
-    QIODevice* audioOutputDevice;
-    int audioPointer = 0;
-    bool audioEnabled = true;
+    bool audioReady = false;
+    bool audioRequested = false;
 
     OnboardingBar* bar;
 
@@ -171,46 +169,26 @@ Onboarding::Onboarding(QWidget* parent) :
         format.setByteOrder(QAudioFormat::LittleEndian);
         format.setSampleType(QAudioFormat::UnSignedInt);
 
-        QEventLoop* loop = new QEventLoop();
-        for (int i = 0; i < 2; i++) {
-            QByteArray* array = (i == 0 ? &d->singleAudioData : &d->loopAudioData);
-            QString setting = (i == 0 ? "Onboarding/audio.start" : "Onboarding/audio.loop");
-
-            QEventLoopLocker* locker = new QEventLoopLocker(loop);
-            QAudioDecoder* audioDecoder = new QAudioDecoder();
-            audioDecoder->setSourceFilename(d->settings.value(setting).toString());
-            audioDecoder->setAudioFormat(format);
-            connect(audioDecoder, &QAudioDecoder::bufferReady, this, [ = ] {
-                QAudioBuffer buf = audioDecoder->read();
-                array->append(buf.constData<char>(), buf.byteCount());
-            });
-            connect(audioDecoder, &QAudioDecoder::finished, this, [ = ] {
-                delete locker;
-                audioDecoder->deleteLater();
-            });
-            connect(audioDecoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error), this, [ = ](QAudioDecoder::Error error) {
-                delete locker;
-                audioDecoder->deleteLater();
-            });
-            audioDecoder->start();
-        }
-        loop->exec();
-        loop->deleteLater();
-
+        //Decode the soundtrack as it plays instead of waiting for all of it up front
+        d->audioStream = new OnboardingAudioStream(format, d->settings.value("Onboarding/audio.start").toString(), d->settings.value("Onboarding/audio.loop").toString(), this);
         d->audioOutput = new QAudioOutput(format);
-        d->audioOutput->setBufferSize(176400);
-        d->audioOutputDevice = d->audioOutput->start();
-        d->audioOutput->setNotifyInterval(1000);
+        d->audioOutput->setBufferSize(format.bytesForDuration(500000));
 
         connect(d->audioOutput, &QAudioOutput::stateChanged, this, [ = ](QAudio::State state) {
             qDebug() << state;
         });
-        connect(d->audioOutput, &QAudioOutput::notify, this, &Onboarding::writeAudio);
+        connect(d->audioStream, &OnboardingAudioStream::ready, this, [ = ] {
+            d->audioReady = true;
+            if (d->audioRequested) d->audioOutput->start(d->audioStream);
+        });
+        d->audioStream->start();
     }
 
     if (d->settings.value("Onboarding/onboardingVideo").toBool()) {
+        //The video tells us when to start playing audio so that they stay in sync
         this->setAttribute(Qt::WA_TranslucentBackground);
     } else {
+        this->startAudio();
         this->startOnboarding();
     }
 }
@@ -220,6 +198,7 @@ Onboarding::~Onboarding() {
         d->audioOutput->stop();
         d->audioOutput->deleteLater();
     }
+    if (d->audioStream) delete d->audioStream;
     delete d;
     delete ui;
 }
@@ -295,31 +274,12 @@ void Onboarding::startOnboarding() {
     ui->contentWrapper->setVisible(true);
 }
 
-void Onboarding::writeAudio() {
-    if (!d->audioEnabled) return;
-    if (!d->audioOutputDevice) return;
-    int bytesFree = d->audioOutput->bytesFree();
-    if (d->audioPointer < d->singleAudioData.count()) {
-        QByteArray chunk = d->singleAudioData.mid(d->audioPointer, bytesFree);
-        d->audioPointer += chunk.count();
-        bytesFree -= chunk.count();
-        d->audioOutputDevice->write(chunk);
-    }
+void Onboarding::startAudio() {
+    if (!d->audioOutput || d->audioRequested) return;
+    d->audioRequested = true;
 
-    //Prevent ourselves from locking up in this loop
-    QDeadlineTimer lockTimer(50);
-    while (bytesFree != 0 && d->audioPointer >= d->singleAudioData.count() && !lockTimer.hasExpired()) {
-        if (d->audioPointer >= d->singleAudioData.count() + d->loopAudioData.count()) d->audioPointer -= d->loopAudioData.count();
-        QByteArray chunk = d->loopAudioData.mid(d->audioPointer - d->singleAudioData.count(), bytesFree);
-        d->audioPointer += chunk.count();
-        bytesFree -= chunk.count();
-        d->audioOutputDevice->write(chunk);
-    }
-
-    //Disable the audio
-    if (lockTimer.hasExpired()) {
-        d->audioEnabled = false;
-    }
+    //Otherwise playback starts as soon as the first few buffers have been decoded
+    if (d->audioReady) d->audioOutput->start(d->audioStream);
 }
 
 void Onboarding::changeEvent(QEvent* event) {
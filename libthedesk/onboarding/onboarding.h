@@ -36,7 +36,7 @@ class Onboarding : public QDialog {
 
         void startOnboarding();
 
-        void writeAudio();
+        void startAudio();
 
     private slots:
         void on_stackedWidget_currentChanged(int arg1);
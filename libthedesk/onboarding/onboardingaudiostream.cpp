@@ -0,0 +1,189 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "onboardingaudiostream.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QAudioDecoder>
+#include <QAudioBuffer>
+
+struct OnboardingAudioStreamPrivate {
+    QThread* thread;
+    QAudioDecoder* decoder;
+    QAudioFormat format;
+    QString introFile;
+    QString loopFile;
+    bool playingLoop = false;
+
+    //Decoded audio waiting to be played, bounded so the whole track is never held in memory
+    mutable QMutex mutex;
+    QByteArray ring;
+    qint64 readPos = 0;
+    qint64 available = 0;
+
+    //A decoded buffer that didn't fit into the ring yet
+    QByteArray pending;
+    bool fillQueued = false;
+
+    qint64 readyThreshold;
+    bool isReady = false;
+};
+
+OnboardingAudioStream::OnboardingAudioStream(QAudioFormat format, QString introFile, QString loopFile, QObject* parent) : QIODevice(parent) {
+    d = new OnboardingAudioStreamPrivate();
+    d->format = format;
+    d->introFile = introFile;
+    d->loopFile = loopFile;
+
+    //Hold two seconds of audio and start playing once a quarter of a second is ready
+    d->ring.resize(format.bytesForDuration(2000000));
+    d->readyThreshold = format.bytesForDuration(250000);
+
+    this->open(QIODevice::ReadOnly);
+
+    //Decode on a worker thread so the UI never waits for the decoder
+    d->thread = new QThread();
+    d->thread->setObjectName("OnboardingAudio");
+    d->decoder = new QAudioDecoder();
+    d->decoder->setAudioFormat(format);
+    d->decoder->moveToThread(d->thread);
+
+    connect(d->decoder, &QAudioDecoder::bufferReady, d->decoder, [ = ] {
+        fillBuffer();
+    });
+    connect(d->decoder, &QAudioDecoder::finished, d->decoder, [ = ] {
+        //Keep playing the loop track until we're told to stop
+        startDecoding(true);
+    });
+    connect(d->decoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error), d->decoder, [ = ](QAudioDecoder::Error error) {
+        if (!d->playingLoop) startDecoding(true);
+    });
+    connect(d->thread, &QThread::finished, d->decoder, &QAudioDecoder::deleteLater);
+
+    d->thread->start();
+}
+
+OnboardingAudioStream::~OnboardingAudioStream() {
+    QMetaObject::invokeMethod(d->decoder, [ = ] {
+        d->decoder->stop();
+    }, Qt::BlockingQueuedConnection);
+    d->thread->quit();
+    d->thread->wait();
+    d->thread->deleteLater();
+    delete d;
+}
+
+void OnboardingAudioStream::start() {
+    QMetaObject::invokeMethod(d->decoder, [ = ] {
+        startDecoding(false);
+    });
+}
+
+bool OnboardingAudioStream::isSequential() const {
+    return true;
+}
+
+qint64 OnboardingAudioStream::bytesAvailable() const {
+    QMutexLocker locker(&d->mutex);
+    return d->available + QIODevice::bytesAvailable();
+}
+
+qint64 OnboardingAudioStream::readData(char* data, qint64 maxlen) {
+    QMutexLocker locker(&d->mutex);
+
+    qint64 read = 0;
+    while (read < maxlen && d->available > 0) {
+        qint64 chunk = qMin(qMin(maxlen - read, d->available), d->ring.size() - d->readPos);
+        memcpy(data + read, d->ring.constData() + d->readPos, chunk);
+        d->readPos = (d->readPos + chunk) % d->ring.size();
+        d->available -= chunk;
+        read += chunk;
+    }
+
+    //Pad with silence if the decoder has fallen behind rather than letting the output go idle
+    if (read < maxlen) {
+        char silence = d->format.sampleType() == QAudioFormat::UnSignedInt && d->format.sampleSize() == 8 ? char(0x80) : 0;
+        memset(data + read, silence, maxlen - read);
+    }
+
+    //Now that there's space, ask the decoder thread for more
+    if (!d->fillQueued) {
+        d->fillQueued = true;
+        QMetaObject::invokeMethod(d->decoder, [ = ] {
+            fillBuffer();
+        });
+    }
+
+    return maxlen;
+}
+
+qint64 OnboardingAudioStream::writeData(const char* data, qint64 len) {
+    Q_UNUSED(data)
+    Q_UNUSED(len)
+    return -1;
+}
+
+void OnboardingAudioStream::startDecoding(bool loop) {
+    QString file = loop ? d->loopFile : d->introFile;
+    d->playingLoop = loop;
+    if (file.isEmpty()) {
+        if (!loop) startDecoding(true);
+        return;
+    }
+
+    d->decoder->stop();
+    d->decoder->setSourceFilename(file);
+    d->decoder->start();
+}
+
+void OnboardingAudioStream::fillBuffer() {
+    bool emitReady = false;
+    {
+        QMutexLocker locker(&d->mutex);
+        d->fillQueued = false;
+
+        forever {
+            if (d->pending.isEmpty()) {
+                //Leave decoded buffers with the decoder, which stops decoding ahead once enough are queued
+                if (!d->decoder->bufferAvailable()) break;
+                QAudioBuffer buf = d->decoder->read();
+                d->pending = QByteArray(buf.constData<char>(), buf.byteCount());
+                if (d->pending.isEmpty()) break;
+            }
+
+            qint64 space = d->ring.size() - d->available;
+            if (space < d->pending.size()) break;
+
+            qint64 writePos = (d->readPos + d->available) % d->ring.size();
+            qint64 firstChunk = qMin<qint64>(d->pending.size(), d->ring.size() - writePos);
+            memcpy(d->ring.data() + writePos, d->pending.constData(), firstChunk);
+            memcpy(d->ring.data(), d->pending.constData() + firstChunk, d->pending.size() - firstChunk);
+            d->available += d->pending.size();
+            d->pending.clear();
+        }
+
+        if (!d->isReady && (d->available >= d->readyThreshold || d->available == d->ring.size())) {
+            d->isReady = true;
+            emitReady = true;
+        }
+    }
+
+    if (emitReady) emit ready();
+}
@@ -0,0 +1,52 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef ONBOARDINGAUDIOSTREAM_H
+#define ONBOARDINGAUDIOSTREAM_H
+
+#include <QIODevice>
+#include <QAudioFormat>
+
+struct OnboardingAudioStreamPrivate;
+class OnboardingAudioStream : public QIODevice {
+        Q_OBJECT
+    public:
+        explicit OnboardingAudioStream(QAudioFormat format, QString introFile, QString loopFile, QObject* parent = nullptr);
+        ~OnboardingAudioStream();
+
+        void start();
+
+        bool isSequential() const;
+        qint64 bytesAvailable() const;
+
+    signals:
+        void ready();
+
+    protected:
+        qint64 readData(char* data, qint64 maxlen);
+        qint64 writeData(const char* data, qint64 len);
+
+    private:
+        OnboardingAudioStreamPrivate* d;
+
+        void startDecoding(bool loop);
+        void fillBuffer();
+};
+
+#endif // ONBOARDINGAUDIOSTREAM_H
@@ -60,7 +60,7 @@ bool OnboardingController::performOnboarding() {
 
         if (videoScreens.count() > 0) {
             connect(videoScreens.first(), &OnboardingVideo::startOnboarding, &o, &Onboarding::startOnboarding);
-            connect(videoScreens.first(), &OnboardingVideo::playAudio, &o, &Onboarding::writeAudio);
+            connect(videoScreens.first(), &OnboardingVideo::playAudio, &o, &Onboarding::startAudio);
         }
 
         //Hide the splashes if needed
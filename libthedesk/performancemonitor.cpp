@@ -0,0 +1,275 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "performancemonitor.h"
+
+#include <QApplication>
+#include <QWidget>
+#include <QTimer>
+#include <QTimerEvent>
+#include <QElapsedTimer>
+#include <QDBusConnection>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QUuid>
+#include <QSet>
+#include "stallwatchdog.h"
+#include "plugins/pluginmanager.h"
+#include "server/sessionserver.h"
+
+#define PERFORMANCE_MONITOR_PROBE_INTERVAL 1000
+
+struct PerformanceMonitorWindowStatistics {
+    int paints = 0;
+    qint64 paintTime = 0;
+    qint64 worstPaint = 0;
+};
+
+struct PerformanceMonitorTimerStatistics {
+    //Every timer seen firing since the last reset; stopped timers are not removed
+    QSet<int> timers;
+    int wakeups = 0;
+};
+
+struct PerformanceMonitorCacheStatistics {
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
+struct PerformanceMonitorPrivate {
+    PerformanceMonitor* instance = nullptr;
+
+    bool collecting = false;
+    QElapsedTimer collectionTimer;
+
+    QTimer* probeTimer;
+    QElapsedTimer probePosted;
+    const QList<qint64> latencyBuckets = {1, 4, 16, 64, 256};
+    QList<quint64> latencyCounts;
+
+    bool inPaint = false;
+    QHash<QString, PerformanceMonitorWindowStatistics> windows;
+    QHash<QString, PerformanceMonitorTimerStatistics> timers;
+
+    QHash<QString, PerformanceMonitorCacheStatistics> caches;
+
+    static const QEvent::Type probeEventType;
+};
+
+PerformanceMonitorPrivate* PerformanceMonitor::d = new PerformanceMonitorPrivate();
+const QEvent::Type PerformanceMonitorPrivate::probeEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+PerformanceMonitor* PerformanceMonitor::instance() {
+    if (!d->instance) d->instance = new PerformanceMonitor();
+    return d->instance;
+}
+
+void PerformanceMonitor::recordCacheLookup(QString cache, bool hit) {
+    //This is cheap, so it is always recorded
+    PerformanceMonitorCacheStatistics& statistics = d->caches[cache];
+    if (hit) {
+        statistics.hits++;
+    } else {
+        statistics.misses++;
+    }
+}
+
+bool PerformanceMonitor::isCollecting() {
+    return d->collecting;
+}
+
+void PerformanceMonitor::setCollecting(bool collecting) {
+    if (d->collecting == collecting) return;
+    d->collecting = collecting;
+
+    //Watching every event costs time, so only do it while someone is interested
+    if (collecting) {
+        reset();
+        qApp->installEventFilter(this);
+        d->probeTimer->start();
+    } else {
+        qApp->removeEventFilter(this);
+        d->probeTimer->stop();
+    }
+}
+
+void PerformanceMonitor::reset() {
+    d->collectionTimer.start();
+    d->latencyCounts = QList<quint64>();
+    for (int i = 0; i <= d->latencyBuckets.count(); i++) d->latencyCounts.append(0);
+    d->windows.clear();
+    d->timers.clear();
+    d->caches.clear();
+}
+
+QJsonObject PerformanceMonitor::statistics() {
+    QJsonObject statistics;
+    qint64 collectionTime = d->collecting ? d->collectionTimer.elapsed() : 0;
+    statistics.insert("collecting", d->collecting);
+    statistics.insert("collectionTime", collectionTime);
+
+    QJsonObject latency;
+    for (int i = 0; i < d->latencyCounts.count(); i++) {
+        QString bucket = i < d->latencyBuckets.count() ? QStringLiteral("<%1ms").arg(d->latencyBuckets.at(i)) : QStringLiteral(">=%1ms").arg(d->latencyBuckets.last());
+        latency.insert(bucket, static_cast<qint64>(d->latencyCounts.at(i)));
+    }
+    statistics.insert("eventLoopLatency", latency);
+
+    QJsonArray windows;
+    for (QString window : d->windows.keys()) {
+        PerformanceMonitorWindowStatistics windowStatistics = d->windows.value(window);
+        windows.append(QJsonObject({
+            {"window", window},
+            {"paints", windowStatistics.paints},
+            {"paintTime", windowStatistics.paintTime},
+            {"worstPaint", windowStatistics.worstPaint}
+        }));
+    }
+    statistics.insert("windows", windows);
+
+    QJsonArray timers;
+    for (QString owner : d->timers.keys()) {
+        PerformanceMonitorTimerStatistics timerStatistics = d->timers.value(owner);
+        timers.append(QJsonObject({
+            {"owner", owner},
+            {"distinctTimersFired", timerStatistics.timers.count()},
+            {"wakeups", timerStatistics.wakeups},
+            {"wakeupsPerSecond", collectionTime == 0 ? 0.0 : timerStatistics.wakeups * 1000.0 / collectionTime}
+        }));
+    }
+    statistics.insert("timers", timers);
+
+    QJsonArray plugins;
+    PluginManager* pluginManager = PluginManager::instance();
+    for (QUuid plugin : pluginManager->loadedPlugins()) {
+        plugins.append(QJsonObject({
+            {"name", pluginManager->pluginMetadata(plugin, "name").toString()},
+            {"activationTime", pluginManager->pluginActivationTime(plugin)},
+            {"instanceChildren", pluginManager->pluginInstanceChildCount(plugin)}
+        }));
+    }
+    statistics.insert("plugins", plugins);
+
+    QJsonArray caches;
+    for (QString cache : d->caches.keys()) {
+        PerformanceMonitorCacheStatistics cacheStatistics = d->caches.value(cache);
+        quint64 lookups = cacheStatistics.hits + cacheStatistics.misses;
+        caches.append(QJsonObject({
+            {"cache", cache},
+            {"hits", static_cast<qint64>(cacheStatistics.hits)},
+            {"misses", static_cast<qint64>(cacheStatistics.misses)},
+            {"hitRate", lookups == 0 ? 0.0 : static_cast<double>(cacheStatistics.hits) / lookups}
+        }));
+    }
+    statistics.insert("caches", caches);
+
+    QJsonArray stalls;
+    for (StallWatchdogOffender offender : StallWatchdog::instance()->worstOffenders()) {
+        stalls.append(QJsonObject({
+            {"component", offender.component},
+            {"stalls", offender.stalls},
+            {"totalDuration", offender.totalDuration},
+            {"worstDuration", offender.worstDuration}
+        }));
+    }
+    statistics.insert("stalls", stalls);
+
+    statistics.insert("autostart", SessionServer::instance()->autostartReport());
+
+    return statistics;
+}
+
+QString PerformanceMonitor::Statistics() {
+    return QJsonDocument(statistics()).toJson(QJsonDocument::Compact);
+}
+
+bool PerformanceMonitor::Collecting() {
+    return isCollecting();
+}
+
+void PerformanceMonitor::SetCollecting(bool collecting) {
+    setCollecting(collecting);
+}
+
+void PerformanceMonitor::Reset() {
+    reset();
+}
+
+PerformanceMonitor::PerformanceMonitor(QObject* parent) : QObject(parent) {
+    reset();
+
+    d->probeTimer = new QTimer(this);
+    d->probeTimer->setInterval(PERFORMANCE_MONITOR_PROBE_INTERVAL);
+    connect(d->probeTimer, &QTimer::timeout, this, &PerformanceMonitor::probeEventLoop);
+
+    QDBusConnection::sessionBus().registerService("com.vicr123.thedesk");
+    QDBusConnection::sessionBus().registerObject("/com/vicr123/thedesk/Performance", this, QDBusConnection::ExportScriptableContents);
+}
+
+bool PerformanceMonitor::eventFilter(QObject* watched, QEvent* event) {
+    switch (event->type()) {
+        case QEvent::Timer: {
+            //Attribute QTimers to whoever owns them
+            QObject* owner = watched;
+            if (watched->inherits("QTimer") && watched->parent()) owner = watched->parent();
+
+            PerformanceMonitorTimerStatistics& timerStatistics = d->timers[owner->metaObject()->className()];
+            timerStatistics.timers.insert(static_cast<QTimerEvent*>(event)->timerId());
+            timerStatistics.wakeups++;
+            break;
+        }
+        case QEvent::UpdateRequest: {
+            if (d->inPaint || !watched->isWidgetType()) break;
+            QWidget* widget = static_cast<QWidget*>(watched);
+            if (!widget->isWindow()) break;
+
+            //Deliver the update ourselves so that the whole repaint of the window can be timed
+            d->inPaint = true;
+            QElapsedTimer paintTimer;
+            paintTimer.start();
+            widget->event(event);
+            qint64 paintTime = paintTimer.elapsed();
+            d->inPaint = false;
+
+            PerformanceMonitorWindowStatistics& windowStatistics = d->windows[QStringLiteral("%1 (%2)").arg(widget->metaObject()->className(), widget->windowTitle())];
+            windowStatistics.paints++;
+            windowStatistics.paintTime += paintTime;
+            windowStatistics.worstPaint = qMax(windowStatistics.worstPaint, paintTime);
+            return true;
+        }
+        default:
+            break;
+    }
+    return false;
+}
+
+void PerformanceMonitor::customEvent(QEvent* event) {
+    if (event->type() != PerformanceMonitorPrivate::probeEventType) return;
+
+    //Measure how long the probe waited in the event queue
+    qint64 latency = d->probePosted.elapsed();
+    int bucket = 0;
+    while (bucket < d->latencyBuckets.count() && latency >= d->latencyBuckets.at(bucket)) bucket++;
+    d->latencyCounts[bucket]++;
+}
+
+void PerformanceMonitor::probeEventLoop() {
+    d->probePosted.start();
+    QCoreApplication::postEvent(this, new QEvent(PerformanceMonitorPrivate::probeEventType));
+}
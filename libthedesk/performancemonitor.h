@@ -0,0 +1,58 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef PERFORMANCEMONITOR_H
+#define PERFORMANCEMONITOR_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <QJsonObject>
+
+struct PerformanceMonitorPrivate;
+class LIBTHEDESK_EXPORT PerformanceMonitor : public QObject {
+        Q_OBJECT
+        Q_CLASSINFO("D-Bus Interface", "com.vicr123.thedesk.Performance")
+
+    public:
+        static PerformanceMonitor* instance();
+
+        static void recordCacheLookup(QString cache, bool hit);
+
+        bool isCollecting();
+        void setCollecting(bool collecting);
+        void reset();
+
+        QJsonObject statistics();
+
+    public Q_SLOTS:
+        Q_SCRIPTABLE QString Statistics();
+        Q_SCRIPTABLE bool Collecting();
+        Q_SCRIPTABLE void SetCollecting(bool collecting);
+        Q_SCRIPTABLE void Reset();
+
+    private:
+        explicit PerformanceMonitor(QObject* parent = nullptr);
+        static PerformanceMonitorPrivate* d;
+
+        bool eventFilter(QObject* watched, QEvent* event);
+        void customEvent(QEvent* event);
+        void probeEventLoop();
+};
+
+#endif // PERFORMANCEMONITOR_H
@@ -26,6 +26,7 @@
 #include <QPluginLoader>
 #include <QDebug>
 #include <QUuid>
+#include <QElapsedTimer>
 #include <tsettings.h>
 #include "plugininterface.h"
 
@@ -37,6 +38,7 @@ struct PluginManagerPrivate {
     QList<QUuid> loadedPlugins;
     QList<QUuid> erroredPlugins;
     QMap<QUuid, QPluginLoaderPtr> foundPlugins;
+    QMap<QUuid, qint64> activationTimes;
 
     tSettings* settings;
     QList<QUuid> blacklistedPlugins;
@@ -95,6 +97,9 @@ void PluginManager::activatePlugin(QUuid uuid) {
 
     d->erroredPlugins.removeAll(uuid);
 
+    QElapsedTimer activationTimer;
+    activationTimer.start();
+
     if (!loader->load()) {
         //Error!
         d->erroredPlugins.append(uuid);
@@ -111,6 +116,7 @@ void PluginManager::activatePlugin(QUuid uuid) {
     }
 
     instance->activate();
+    d->activationTimes.insert(uuid, activationTimer.elapsed());
     d->loadedPlugins.append(uuid);
     emit pluginsChanged();
 }
@@ -204,6 +210,24 @@ QString PluginManager::pluginErrorReason(QUuid plugin) {
     return loader->errorString();
 }
 
+qint64 PluginManager::pluginActivationTime(QUuid plugin) {
+    return d->activationTimes.value(plugin, -1);
+}
+
+//Only counts the plugin instance and its QObject children; objects the plugin parents elsewhere are not included
+int PluginManager::pluginInstanceChildCount(QUuid plugin) {
+    if (!d->loadedPlugins.contains(plugin)) return 0;
+    QObject* instance = d->foundPlugins.value(plugin)->instance();
+    if (!instance) return 0;
+    return instance->findChildren<QObject*>().count() + 1;
+}
+
+QString PluginManager::pluginLibrary(QUuid plugin) {
+    QPluginLoaderPtr loader = d->foundPlugins.value(plugin);
+    if (!loader) return "";
+    return loader->fileName();
+}
+
 PluginManager::PluginManager(QObject* parent) : QObject(parent) {
     d->settings = new tSettings();
 
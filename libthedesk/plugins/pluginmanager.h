@@ -45,6 +45,9 @@ class PluginManager : public QObject {
         QList<QUuid> blacklistedPlugins();
         QJsonValue pluginMetadata(QUuid plugin, QString key);
         QString pluginErrorReason(QUuid plugin);
+        QString pluginLibrary(QUuid plugin);
+        qint64 pluginActivationTime(QUuid plugin);
+        int pluginInstanceChildCount(QUuid plugin);
 
     signals:
         void pluginsChanged();
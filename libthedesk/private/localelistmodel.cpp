@@ -0,0 +1,145 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "localelistmodel.h"
+
+#include <algorithm>
+
+struct LocaleListEntry {
+    QLocale::Language language;
+    QString text;
+    QString searchText;
+};
+
+struct LocaleListCatalogue {
+    //Entries never move once built, so models can keep indices into this list
+    QList<LocaleListEntry> entries;
+    QList<int> sorted;
+    QString sortLocale;
+    bool built = false;
+
+    void build();
+    void sort();
+};
+
+struct LocaleListModelPrivate {
+    static LocaleListCatalogue catalogue;
+
+    //The sort order this model was created with; a later re-sort for another locale doesn't affect it
+    QList<int> order;
+    QList<int> visible;
+    QString filter;
+};
+
+LocaleListCatalogue LocaleListModelPrivate::catalogue;
+
+void LocaleListCatalogue::build() {
+    //Constructing a QLocale for every language is expensive, so only do this once per process
+    if (!built) {
+        for (int i = QLocale::C + 1; i < QLocale::LastLanguage; i++) {
+#if !QT_VERSION_CHECK(5, 15, 0)
+            if (i == QLocale::UncodedLanguages) continue;
+#endif
+            QLocale locale(static_cast<QLocale::Language>(i));
+            if (locale.language() != i) continue;
+
+            QString native = locale.nativeLanguageName();
+            if (native.isEmpty()) continue;
+
+            LocaleListEntry entry;
+            entry.language = locale.language();
+            if (locale.language() == QLocale::English) {
+                entry.text = "English"; //Do not localise
+            } else {
+                entry.text = QStringLiteral("%1 (%2)").arg(native).arg(QLocale::languageToString(locale.language()));
+            }
+            entry.searchText = entry.text.toCaseFolded();
+            entries.append(entry);
+        }
+        built = true;
+    }
+
+    //The sort order depends on the collation of the current locale
+    if (sortLocale != QLocale().bcp47Name()) sort();
+}
+
+void LocaleListCatalogue::sort() {
+    //Build a new list rather than sorting in place, because other models may still hold the old one
+    QList<int> order;
+    for (int i = 0; i < entries.count(); i++) order.append(i);
+    std::sort(order.begin(), order.end(), [ = ](int first, int second) {
+        return entries.at(first).text.localeAwareCompare(entries.at(second).text) < 0;
+    });
+    sorted = order;
+    sortLocale = QLocale().bcp47Name();
+}
+
+LocaleListModel::LocaleListModel(QObject* parent)
+    : QAbstractListModel(parent) {
+    d = new LocaleListModelPrivate();
+
+    d->catalogue.build();
+    d->order = d->catalogue.sorted;
+    setFilter("");
+}
+
+LocaleListModel::~LocaleListModel() {
+    delete d;
+}
+
+void LocaleListModel::setFilter(QString filter) {
+    QString folded = filter.trimmed().toCaseFolded();
+    if (d->filter == folded && !d->visible.isEmpty()) return;
+
+    //If the user is narrowing the search, only look through what is already visible
+    QList<int> candidates;
+    if (!d->filter.isEmpty() && folded.contains(d->filter)) {
+        candidates = d->visible;
+    } else {
+        candidates = d->order;
+    }
+
+    beginResetModel();
+    d->filter = folded;
+    d->visible.clear();
+    for (int i : qAsConst(candidates)) {
+        if (folded.isEmpty() || d->catalogue.entries.at(i).searchText.contains(folded)) d->visible.append(i);
+    }
+    endResetModel();
+}
+
+int LocaleListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+
+    return d->visible.count();
+}
+
+QVariant LocaleListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) return QVariant();
+
+    const LocaleListEntry& entry = d->catalogue.entries.at(d->visible.at(index.row()));
+    switch (role) {
+        case Qt::DisplayRole:
+            return entry.text;
+        case LanguageRole:
+            return entry.language;
+    }
+
+    return QVariant();
+}
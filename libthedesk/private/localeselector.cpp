@@ -20,8 +20,11 @@
 #include "localeselector.h"
 #include "ui_localeselector.h"
 
+#include "localelistmodel.h"
+
 struct LocaleSelectorPrivate {
     QLocale::Language currentLanguage;
+    LocaleListModel* model;
 };
 
 LocaleSelector::LocaleSelector(QWidget* parent) :
@@ -34,38 +37,8 @@ LocaleSelector::LocaleSelector(QWidget* parent) :
     ui->languageTitle->setBackButtonShown(true);
     ui->stackedWidget->setCurrentAnimation(tStackedWidget::SlideHorizontal);
 
-    QList<QListWidgetItem*> languages;
-    for (int i = QLocale::C + 1; i < QLocale::LastLanguage; i++) {
-#if !QT_VERSION_CHECK(5, 15, 0)
-        if (i == QLocale::UncodedLanguages) continue;
-#endif
-        QLocale locale(static_cast<QLocale::Language>(i));
-        if (locale.language() != i) continue;
-        if (!locale.nativeLanguageName().isEmpty()) {
-            QString text;
-            QString native = locale.nativeLanguageName();
-            if (locale.language() == QLocale::English) {
-                text = "English"; //Do not localise
-            } else if (native.isEmpty()) {
-                text = QLocale::languageToString(locale.language());
-            } else {
-                text = QStringLiteral("%1 (%2)").arg(native).arg(QLocale::languageToString(locale.language()));
-            }
-
-            QListWidgetItem* item = new QListWidgetItem();
-            item->setText(text);
-            item->setData(Qt::UserRole, i);
-            languages.append(item);
-        }
-    }
-
-    std::sort(languages.begin(), languages.end(), [ = ](const QListWidgetItem * first, const QListWidgetItem * second) {
-        return first->text().localeAwareCompare(second->text()) < 0;
-    });
-
-    for (QListWidgetItem* item : languages) {
-        ui->languageSelection->addItem(item);
-    }
+    d->model = new LocaleListModel(this);
+    ui->languageSelection->setModel(d->model);
 }
 
 LocaleSelector::~LocaleSelector() {
@@ -77,8 +50,8 @@ void LocaleSelector::on_titleLabel_backButtonClicked() {
     emit rejected();
 }
 
-void LocaleSelector::on_languageSelection_itemActivated(QListWidgetItem* item) {
-    QLocale::Language lang = static_cast<QLocale::Language>(item->data(Qt::UserRole).toInt());
+void LocaleSelector::on_languageSelection_activated(const QModelIndex& index) {
+    QLocale::Language lang = static_cast<QLocale::Language>(index.data(LocaleListModel::LanguageRole).toInt());
     d->currentLanguage = lang;
     QList<QLocale::Country> countries = QLocale::countriesForLanguage(lang);
     if (countries.count() == 1) {
@@ -107,3 +80,7 @@ void LocaleSelector::on_localeSelection_itemActivated(QListWidgetItem* item) {
 void LocaleSelector::on_languageTitle_backButtonClicked() {
     ui->stackedWidget->setCurrentWidget(ui->languagePage);
 }
+
+void LocaleSelector::on_searchBox_textChanged(const QString& text) {
+    d->model->setFilter(text);
+}
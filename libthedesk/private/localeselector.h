@@ -43,12 +43,14 @@ class LocaleSelector : public QWidget {
     private slots:
         void on_titleLabel_backButtonClicked();
 
-        void on_languageSelection_itemActivated(QListWidgetItem* item);
+        void on_languageSelection_activated(const QModelIndex& index);
 
         void on_localeSelection_itemActivated(QListWidgetItem* item);
 
         void on_languageTitle_backButtonClicked();
 
+        void on_searchBox_textChanged(const QString& text);
+
     private:
         Ui::LocaleSelector* ui;
         LocaleSelectorPrivate* d;
@@ -25,6 +25,7 @@
 #include <tvariantanimation.h>
 #include <statemanager.h>
 #include <barmanager.h>
+#include <animationclock.h>
 #include "chunk.h"
 
 struct QuickWidgetContainerPrivate {
@@ -53,8 +54,11 @@ QuickWidgetContainer::QuickWidgetContainer(Chunk* parent) :
     d->yAnim->setEasingCurve(QEasingCurve::OutCubic);
     d->yAnim->setDuration(100);
     connect(d->yAnim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        this->move(this->x(), value.toInt());
+        StateManager::animationClock()->scheduleFrameWork(this, "y", [ = ] {
+            this->move(this->x(), value.toInt());
+        });
     });
+    StateManager::animationClock()->registerAnimation(d->yAnim);
 
     d->opacityAnim = new tVariantAnimation(this);
     d->opacityAnim->setStartValue(0.0);
@@ -65,7 +69,10 @@ QuickWidgetContainer::QuickWidgetContainer(Chunk* parent) :
         this->setWindowOpacity(value.toDouble());
     });
     connect(d->opacityAnim, &tVariantAnimation::finished, this, [ = ] {
-        if (d->opacityAnim->direction() == tVariantAnimation::Backward) this->hide();
+        if (d->opacityAnim->direction() == tVariantAnimation::Backward) {
+            this->hide();
+            emit containerHidden();
+        }
     });
 
     this->setWindowOpacity(0);
@@ -38,6 +38,9 @@ class QuickWidgetContainer : public QWidget {
         void showContainer();
         void hideContainer();
 
+    signals:
+        void containerHidden();
+
     private:
         Ui::QuickWidgetContainer* ui;
         QuickWidgetContainerPrivate* d;
@@ -21,6 +21,7 @@
 
 #include "statemanager.h"
 #include "onboardingmanager.h"
+#include "server/sessionserver.h"
 
 struct QuietModeManagerPrivate {
     QuietModeManager::QuietMode quietMode = QuietModeManager::Sound;
@@ -28,6 +29,12 @@ struct QuietModeManagerPrivate {
 
 QuietModeManager::QuietModeManager(QObject* parent) : QObject(parent) {
     d = new QuietModeManagerPrivate();
+
+    //Pick up where we left off if the shell is being restarted after a crash
+    connect(SessionServer::instance(), &SessionServer::stateRestored, this, [ = ] {
+        QJsonValue quietMode = SessionServer::instance()->restoredState("quietMode");
+        if (SessionServer::instance()->isHotRestart() && quietMode.isDouble()) this->setQuietMode(static_cast<QuietMode>(quietMode.toInt()));
+    });
 }
 
 QuietModeManager::~QuietModeManager() {
@@ -37,6 +44,7 @@ QuietModeManager::~QuietModeManager() {
 void QuietModeManager::setQuietMode(QuietModeManager::QuietMode quietMode) {
     QuietModeManager::QuietMode oldMode = d->quietMode;
     d->quietMode = quietMode;
+    SessionServer::instance()->setRestorableState("quietMode", quietMode);
     emit quietModeChanged(quietMode, oldMode);
 }
 
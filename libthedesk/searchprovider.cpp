@@ -0,0 +1,81 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "searchprovider.h"
+
+#include <QAtomicInt>
+
+struct SearchQueryPrivate {
+    QString query;
+    QAtomicInt cancelled = 0;
+    QAtomicInt finished = 0;
+};
+
+SearchQuery::SearchQuery(QString query) : QObject(nullptr) {
+    d = new SearchQueryPrivate();
+    d->query = query;
+}
+
+QSharedPointer<SearchQuery> SearchQuery::create(QString query) {
+    //The last reference may be dropped by a provider on a worker thread, so delete on the thread the query lives on
+    return QSharedPointer<SearchQuery>(new SearchQuery(query), &QObject::deleteLater);
+}
+
+SearchQuery::~SearchQuery() {
+    delete d;
+}
+
+QString SearchQuery::query() {
+    return d->query;
+}
+
+bool SearchQuery::isCancelled() {
+    return d->cancelled.loadAcquire();
+}
+
+void SearchQuery::addResults(QList<SearchResult> results) {
+    if (isCancelled() || d->finished.loadAcquire() || results.isEmpty()) return;
+
+    //Hand the results over to the thread the query lives on, checking again in case it was cancelled in the meantime
+    QMetaObject::invokeMethod(this, [ = ] {
+        if (isCancelled()) return;
+        emit resultsAvailable(results);
+    });
+}
+
+void SearchQuery::finish() {
+    if (!d->finished.testAndSetOrdered(0, 1)) return;
+    QMetaObject::invokeMethod(this, [ = ] {
+        if (isCancelled()) return;
+        emit finished();
+    });
+}
+
+void SearchQuery::cancel() {
+    if (!d->cancelled.testAndSetOrdered(0, 1)) return;
+    emit cancelled();
+}
+
+SearchProvider::SearchProvider(QObject* parent) : QObject(parent) {
+
+}
+
+int SearchProvider::deadline() {
+    return 500;
+}
@@ -0,0 +1,81 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef SEARCHPROVIDER_H
+#define SEARCHPROVIDER_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <QIcon>
+#include <QSharedPointer>
+#include <functional>
+
+struct SearchResult {
+    QString title;
+    QString description;
+    QIcon icon;
+    std::function<void()> activate;
+};
+
+struct SearchQueryPrivate;
+class LIBTHEDESK_EXPORT SearchQuery : public QObject {
+        Q_OBJECT
+    public:
+        ~SearchQuery();
+
+        static QSharedPointer<SearchQuery> create(QString query);
+
+        QString query();
+
+        //These are safe to call from any thread
+        bool isCancelled();
+        void addResults(QList<SearchResult> results);
+        void finish();
+
+        void cancel();
+
+    signals:
+        void resultsAvailable(QList<SearchResult> results);
+        void finished();
+        void cancelled();
+
+    private:
+        explicit SearchQuery(QString query);
+        SearchQueryPrivate* d;
+};
+typedef QSharedPointer<SearchQuery> SearchQueryPtr;
+
+class LIBTHEDESK_EXPORT SearchProvider : public QObject {
+        Q_OBJECT
+    public:
+        explicit SearchProvider(QObject* parent = nullptr);
+
+        virtual QString name() = 0;
+
+        //Results that arrive after this many milliseconds are discarded
+        virtual int deadline();
+
+        //Report results to the query as they become available, then call finish. Anything slow should be done off the main thread.
+        //Hold on to the query for as long as you're working on it; it stays valid (although possibly cancelled) until you let go.
+        virtual void search(SearchQueryPtr query) = 0;
+};
+
+Q_DECLARE_METATYPE(SearchResult)
+
+#endif // SEARCHPROVIDER_H
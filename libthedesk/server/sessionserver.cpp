@@ -21,15 +21,27 @@
 
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QLocalSocket>
 #include <QDebug>
 #include <QMessageBox>
+#include <QElapsedTimer>
+#include <QTimer>
 
 struct SessionServerPrivate {
     QLocalSocket* socket;
     SessionServer* instance = nullptr;
 
     bool available = false;
+    QByteArray buffer;
+
+    QJsonArray autostartReport;
+
+    bool stateReceived = false;
+    bool hotRestart = false;
+    QJsonObject restoredState;
+    QJsonObject restorableState;
+    QTimer* checkpointTimer;
 
     bool havePendingQuestion = false;
     tPromiseFunctions<bool>::SuccessFunction questionRes;
@@ -46,31 +58,63 @@ void SessionServer::setServerPath(QString serverPath) {
     d->socket->connectToServer(serverPath);
 
     //Wait until connection so we can send messages
-    d->socket->waitForConnected();
+    if (!d->socket->waitForConnected()) return;
+
+    //startdesk tells us straight away whether we're coming back from a crash, along with any state to pick up
+    QElapsedTimer timer;
+    timer.start();
+    while (!d->stateReceived && timer.elapsed() < 1000) {
+        if (!d->socket->waitForReadyRead(1000 - timer.elapsed())) break;
+    }
 }
 
 void SessionServer::hideSplashes() {
     if (!d->available) return;
-    d->socket->write(QJsonDocument(QJsonObject({
+    sendMessage(QJsonObject({
         {"type", "hideSplash"}
-    })).toJson());
-    d->socket->flush();
+    }));
 }
 
 void SessionServer::showSplashes() {
     if (!d->available) return;
-    d->socket->write(QJsonDocument(QJsonObject({
+    sendMessage(QJsonObject({
         {"type", "showSplash"}
-    })).toJson());
-    d->socket->flush();
+    }));
 }
 
 void SessionServer::performAutostart() {
     if (!d->available) return;
-    d->socket->write(QJsonDocument(QJsonObject({
+    sendMessage(QJsonObject({
         {"type", "autoStart"}
-    })).toJson());
-    d->socket->flush();
+    }));
+}
+
+QJsonArray SessionServer::autostartReport() {
+    return d->autostartReport;
+}
+
+bool SessionServer::isHotRestart() {
+    return d->hotRestart;
+}
+
+QJsonValue SessionServer::restoredState(QString key) {
+    return d->restoredState.value(key);
+}
+
+void SessionServer::setRestorableState(QString key, QJsonValue state) {
+    if (d->restorableState.value(key) == state) return;
+    d->restorableState.insert(key, state);
+
+    //Coalesce bursts of changes into a single checkpoint
+    if (!d->checkpointTimer->isActive()) d->checkpointTimer->start();
+}
+
+void SessionServer::sendCheckpoint() {
+    if (!d->available) return;
+    sendMessage(QJsonObject({
+        {"type", "checkpoint"},
+        {"state", d->restorableState}
+    }));
 }
 
 tPromise<bool>* SessionServer::askQuestion(QString title, QString question) {
@@ -85,12 +129,11 @@ tPromise<bool>* SessionServer::askQuestion(QString title, QString question) {
             };
             d->havePendingQuestion = true;
 
-            d->socket->write(QJsonDocument(QJsonObject({
+            sendMessage(QJsonObject({
                 {"type", "question"},
                 {"title", title},
                 {"question", question}
-            })).toJson());
-            d->socket->flush();
+            }));
         }
     });
 }
@@ -106,17 +149,47 @@ SessionServer::SessionServer(QObject* parent) : QObject(parent) {
     });
 
     connect(d->socket, &QLocalSocket::readyRead, this, &SessionServer::readData);
+
+    d->checkpointTimer = new QTimer(this);
+    d->checkpointTimer->setInterval(1000);
+    d->checkpointTimer->setSingleShot(true);
+    connect(d->checkpointTimer, &QTimer::timeout, this, &SessionServer::sendCheckpoint);
+}
+
+void SessionServer::sendMessage(QJsonObject message) {
+    //Messages are framed one per line; compact JSON never contains a raw newline
+    d->socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact).append('\n'));
+    d->socket->flush();
 }
 
 void SessionServer::readData() {
-    QByteArray data = d->socket->readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isObject()) {
+    d->buffer.append(d->socket->readAll());
+
+    int newline;
+    while ((newline = d->buffer.indexOf('\n')) != -1) {
+        QByteArray data = d->buffer.left(newline);
+        d->buffer.remove(0, newline + 1);
+
+        QJsonDocument doc = QJsonDocument::fromJson(data);
+        if (!doc.isObject()) continue;
+
         QJsonObject obj = doc.object();
         if (obj.contains("type")) {
             QString type = obj.value("type").toString();
             if (type == "questionResponse" && d->havePendingQuestion) {
                 d->questionRes(obj.value("response").toBool());
+            } else if (type == "autostartReport") {
+                obj.remove("type");
+                d->autostartReport.append(obj);
+                emit autostartEntryLaunched(obj);
+            } else if (type == "sessionState") {
+                d->stateReceived = true;
+                d->hotRestart = obj.value("hotRestart").toBool();
+                d->restoredState = obj.value("state").toObject();
+
+                //Carry the restored state forward so the next checkpoint doesn't drop anything not yet rehydrated
+                d->restorableState = d->restoredState;
+                emit stateRestored();
             }
         }
     }
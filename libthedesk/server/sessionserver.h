@@ -22,6 +22,9 @@
 
 #include <QObject>
 #include <tpromise.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
 
 struct SessionServerPrivate;
 class SessionServer : public QObject {
@@ -34,16 +37,25 @@ class SessionServer : public QObject {
         void hideSplashes();
         void showSplashes();
         void performAutostart();
+        QJsonArray autostartReport();
+
+        bool isHotRestart();
+        QJsonValue restoredState(QString key);
+        void setRestorableState(QString key, QJsonValue state);
 
         tPromise<bool>* askQuestion(QString title, QString question);
 
     signals:
+        void autostartEntryLaunched(QJsonObject report);
+        void stateRestored();
 
     private:
         explicit SessionServer(QObject* parent = nullptr);
         static SessionServerPrivate* d;
 
         void readData();
+        void sendMessage(QJsonObject message);
+        void sendCheckpoint();
 };
 
 #endif // SESSIONSERVER_H
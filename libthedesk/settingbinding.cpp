@@ -0,0 +1,61 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "settingbinding.h"
+
+#include <tsettings.h>
+
+struct SettingBindingBasePrivate {
+    tSettings* settings;
+    QString key;
+
+    static tSettings* defaultSettings;
+};
+
+tSettings* SettingBindingBasePrivate::defaultSettings = nullptr;
+
+SettingBindingBase::SettingBindingBase(tSettings* settings, QString key, QObject* parent) : QObject(parent) {
+    d = new SettingBindingBasePrivate();
+    d->key = key;
+
+    if (settings) {
+        d->settings = settings;
+    } else {
+        //Share one settings object between all default bindings
+        if (!SettingBindingBasePrivate::defaultSettings) SettingBindingBasePrivate::defaultSettings = new tSettings();
+        d->settings = SettingBindingBasePrivate::defaultSettings;
+    }
+
+    connect(d->settings, &tSettings::settingChanged, this, [ = ](QString key, QVariant value) {
+        if (key != d->key) return;
+        if (reload(value)) emit changed();
+    });
+}
+
+SettingBindingBase::~SettingBindingBase() {
+    delete d;
+}
+
+QString SettingBindingBase::key() {
+    return d->key;
+}
+
+QVariant SettingBindingBase::currentValue() {
+    return d->settings->value(d->key);
+}
@@ -0,0 +1,81 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef SETTINGBINDING_H
+#define SETTINGBINDING_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <QVariant>
+
+class tSettings;
+struct SettingBindingBasePrivate;
+class LIBTHEDESK_EXPORT SettingBindingBase : public QObject {
+        Q_OBJECT
+    public:
+        ~SettingBindingBase();
+
+        QString key();
+
+    signals:
+        void changed();
+
+    protected:
+        explicit SettingBindingBase(tSettings* settings, QString key, QObject* parent);
+
+        QVariant currentValue();
+
+        //Return true if the cached value changed
+        virtual bool reload(QVariant value) = 0;
+
+    private:
+        SettingBindingBasePrivate* d;
+};
+
+//Caches the converted value of a single settings key so that hot paths don't have to go through tSettings
+template<typename T> class SettingBinding : public SettingBindingBase {
+    public:
+        explicit SettingBinding(QString key, QObject* parent = nullptr) : SettingBindingBase(nullptr, key, parent) {
+            reload(currentValue());
+        }
+        explicit SettingBinding(tSettings* settings, QString key, QObject* parent = nullptr) : SettingBindingBase(settings, key, parent) {
+            reload(currentValue());
+        }
+
+        T value() const {
+            return cachedValue;
+        }
+
+        operator T() const {
+            return cachedValue;
+        }
+
+    protected:
+        bool reload(QVariant value) override {
+            T newValue = value.value<T>();
+            if (newValue == cachedValue) return false;
+            cachedValue = newValue;
+            return true;
+        }
+
+    private:
+        T cachedValue = T();
+};
+
+#endif // SETTINGBINDING_H
@@ -0,0 +1,271 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "stallwatchdog.h"
+
+#include <QThread>
+#include <QTimer>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QUuid>
+#include <atomic>
+#include <csignal>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include "settingbinding.h"
+#include "plugins/pluginmanager.h"
+
+#define STALL_WATCHDOG_HEARTBEAT_INTERVAL 100
+#define STALL_WATCHDOG_SAMPLE_SIGNAL (SIGRTMIN + 7)
+#define STALL_WATCHDOG_MAX_FRAMES 64
+#define STALL_WATCHDOG_RECENT_STALLS 50
+
+namespace {
+    //Written by the signal handler on the main thread and read by the watchdog thread
+    void* sampleFrames[STALL_WATCHDOG_MAX_FRAMES];
+    std::atomic<int> sampleFrameCount(0);
+    std::atomic<bool> sampleReady(false);
+
+    void sampleMainThread(int) {
+        sampleFrameCount = backtrace(sampleFrames, STALL_WATCHDOG_MAX_FRAMES);
+        sampleReady = true;
+    }
+}
+
+struct StallWatchdogPrivate {
+    StallWatchdog* instance = nullptr;
+
+    SettingBinding<bool>* enabled;
+    SettingBinding<int>* threshold;
+
+    QThread* thread = nullptr;
+    QTimer* heartbeatTimer;
+    pthread_t mainThread;
+
+    QElapsedTimer clock;
+    std::atomic<qint64> lastBeat;
+    std::atomic<qint64> thresholdMs;
+    std::atomic<bool> running;
+
+    //Sample captured by the watchdog thread, attributed on the main thread once it recovers
+    QMutex sampleLock;
+    bool samplePending = false;
+    QStringList sampleLibraries;
+    QStringList sampleBacktrace;
+
+    QList<StallWatchdogStall> recentStalls;
+    QMap<QString, StallWatchdogOffender> offenders;
+};
+
+StallWatchdogPrivate* StallWatchdog::d = new StallWatchdogPrivate();
+
+StallWatchdog* StallWatchdog::instance() {
+    if (!d->instance) d->instance = new StallWatchdog();
+    return d->instance;
+}
+
+bool StallWatchdog::isRunning() {
+    return d->running;
+}
+
+qint64 StallWatchdog::threshold() {
+    return d->thresholdMs;
+}
+
+QList<StallWatchdogStall> StallWatchdog::recentStalls() {
+    return d->recentStalls;
+}
+
+QList<StallWatchdogOffender> StallWatchdog::worstOffenders() {
+    QList<StallWatchdogOffender> offenders = d->offenders.values();
+    std::sort(offenders.begin(), offenders.end(), [ = ](const StallWatchdogOffender & first, const StallWatchdogOffender & second) {
+        return first.totalDuration > second.totalDuration;
+    });
+    return offenders;
+}
+
+StallWatchdog::StallWatchdog(QObject* parent) : QObject(parent) {
+    d->clock.start();
+    d->lastBeat = 0;
+    d->running = false;
+    d->mainThread = pthread_self();
+
+    d->heartbeatTimer = new QTimer(this);
+    d->heartbeatTimer->setInterval(STALL_WATCHDOG_HEARTBEAT_INTERVAL);
+    connect(d->heartbeatTimer, &QTimer::timeout, this, &StallWatchdog::heartbeat);
+
+    d->enabled = new SettingBinding<bool>("Debug/watchdog.enabled", this);
+    d->threshold = new SettingBinding<int>("Debug/watchdog.threshold", this);
+    d->thresholdMs = d->threshold->value();
+    connect(d->enabled, &SettingBindingBase::changed, this, [ = ] {
+        if (d->enabled->value()) {
+            start();
+        } else {
+            stop();
+        }
+    });
+    connect(d->threshold, &SettingBindingBase::changed, this, [ = ] {
+        d->thresholdMs = d->threshold->value();
+    });
+
+    if (d->enabled->value()) start();
+}
+
+void StallWatchdog::start() {
+    if (d->running) return;
+
+    struct sigaction action = {};
+    action.sa_handler = sampleMainThread;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(STALL_WATCHDOG_SAMPLE_SIGNAL, &action, nullptr);
+
+    //Call backtrace once now so that libgcc is loaded outside of the signal handler
+    void* warmup[1];
+    backtrace(warmup, 1);
+
+    d->running = true;
+    d->lastBeat = d->clock.elapsed();
+    d->heartbeatTimer->start();
+
+    d->thread = QThread::create([ = ] {
+        qint64 sampledBeat = -1;
+        while (d->running) {
+            QThread::msleep(STALL_WATCHDOG_HEARTBEAT_INTERVAL / 2);
+
+            qint64 lastBeat = d->lastBeat;
+            if (lastBeat == sampledBeat) continue;
+            if (d->clock.elapsed() - lastBeat < STALL_WATCHDOG_HEARTBEAT_INTERVAL + d->thresholdMs) continue;
+
+            //The main thread has stalled; find out what it is doing
+            sampledBeat = lastBeat;
+            sampleReady = false;
+            pthread_kill(d->mainThread, STALL_WATCHDOG_SAMPLE_SIGNAL);
+            for (int i = 0; i < 20 && !sampleReady; i++) QThread::msleep(5);
+            if (!sampleReady) continue;
+
+            QStringList libraries, backtrace;
+            for (int i = 0; i < sampleFrameCount; i++) {
+                Dl_info info;
+                if (dladdr(sampleFrames[i], &info) == 0) {
+                    libraries.append("");
+                    backtrace.append(QStringLiteral("0x%1").arg(reinterpret_cast<quintptr>(sampleFrames[i]), 0, 16));
+                    continue;
+                }
+
+                libraries.append(QString::fromLocal8Bit(info.dli_fname));
+                backtrace.append(QStringLiteral("%1 (%2)").arg(info.dli_sname ? QString::fromLocal8Bit(info.dli_sname) : QStringLiteral("??"), QFileInfo(QString::fromLocal8Bit(info.dli_fname)).fileName()));
+            }
+
+            QMutexLocker locker(&d->sampleLock);
+            d->samplePending = true;
+            d->sampleLibraries = libraries;
+            d->sampleBacktrace = backtrace;
+        }
+    });
+    d->thread->start();
+}
+
+void StallWatchdog::stop() {
+    if (!d->running) return;
+
+    d->running = false;
+    d->heartbeatTimer->stop();
+    d->thread->wait();
+    d->thread->deleteLater();
+    d->thread = nullptr;
+}
+
+void StallWatchdog::heartbeat() {
+    qint64 now = d->clock.elapsed();
+    qint64 gap = now - d->lastBeat - STALL_WATCHDOG_HEARTBEAT_INTERVAL;
+    d->lastBeat = now;
+
+    QMutexLocker locker(&d->sampleLock);
+    if (!d->samplePending) return;
+    d->samplePending = false;
+    QStringList libraries = d->sampleLibraries;
+    QStringList backtrace = d->sampleBacktrace;
+    locker.unlock();
+
+    recordStall(gap, libraries, backtrace);
+}
+
+void StallWatchdog::recordStall(qint64 duration, QStringList libraries, QStringList backtrace) {
+    //Map the loaded plugins to their libraries
+    QMap<QString, QString> pluginLibraries;
+    PluginManager* plugins = PluginManager::instance();
+    for (QUuid plugin : plugins->loadedPlugins()) {
+        pluginLibraries.insert(QFileInfo(plugins->pluginLibrary(plugin)).canonicalFilePath(), plugins->pluginMetadata(plugin, "name").toString());
+    }
+
+    //Blame the innermost plugin on the stack
+    QString component = QStringLiteral("theDesk");
+    for (QString library : libraries) {
+        QString canonicalLibrary = QFileInfo(library).canonicalFilePath();
+        if (pluginLibraries.contains(canonicalLibrary)) {
+            component = pluginLibraries.value(canonicalLibrary);
+            break;
+        }
+    }
+
+    StallWatchdogStall stall;
+    stall.time = QDateTime::currentDateTime();
+    stall.duration = duration;
+    stall.component = component;
+    stall.backtrace = backtrace;
+
+    d->recentStalls.prepend(stall);
+    while (d->recentStalls.count() > STALL_WATCHDOG_RECENT_STALLS) d->recentStalls.removeLast();
+
+    StallWatchdogOffender& offender = d->offenders[component];
+    offender.component = component;
+    offender.stalls++;
+    offender.totalDuration += duration;
+    offender.worstDuration = qMax(offender.worstDuration, duration);
+
+    qWarning() << "Main thread stalled for" << duration << "ms in" << component;
+    writeLog();
+    emit stallDetected(stall);
+}
+
+void StallWatchdog::writeLog() {
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    cacheDir.mkpath("theDesk");
+
+    QFile log(cacheDir.absoluteFilePath("theDesk/stalls.log"));
+    if (!log.open(QFile::WriteOnly | QFile::Truncate)) return;
+
+    for (StallWatchdogOffender offender : worstOffenders()) {
+        log.write(QStringLiteral("%1: %2 stalls, %3 ms total, %4 ms worst\n").arg(offender.component).arg(offender.stalls).arg(offender.totalDuration).arg(offender.worstDuration).toUtf8());
+    }
+
+    for (StallWatchdogStall stall : d->recentStalls) {
+        log.write(QStringLiteral("\n%1 %2 ms %3\n").arg(stall.time.toString(Qt::ISODate)).arg(stall.duration).arg(stall.component).toUtf8());
+        for (QString frame : stall.backtrace) {
+            log.write(QStringLiteral("    %1\n").arg(frame).toUtf8());
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <QDateTime>
+
+struct StallWatchdogStall {
+    QDateTime time;
+    qint64 duration;
+    QString component;
+    QStringList backtrace;
+};
+
+struct StallWatchdogOffender {
+    QString component;
+    int stalls = 0;
+    qint64 totalDuration = 0;
+    qint64 worstDuration = 0;
+};
+
+struct StallWatchdogPrivate;
+class LIBTHEDESK_EXPORT StallWatchdog : public QObject {
+        Q_OBJECT
+    public:
+        static StallWatchdog* instance();
+
+        bool isRunning();
+        qint64 threshold();
+
+        QList<StallWatchdogStall> recentStalls();
+        QList<StallWatchdogOffender> worstOffenders();
+
+    signals:
+        void stallDetected(StallWatchdogStall stall);
+
+    private:
+        explicit StallWatchdog(QObject* parent = nullptr);
+        static StallWatchdogPrivate* d;
+
+        void start();
+        void stop();
+        void heartbeat();
+        void recordStall(qint64 duration, QStringList libraries, QStringList backtrace);
+        void writeLog();
+};
+
+#endif // STALLWATCHDOG_H
@@ -27,6 +27,10 @@
 #include "gatewaymanager.h"
 #include "onboardingmanager.h"
 #include "quietmodemanager.h"
+#include "windowstatemanager.h"
+#include "animationclock.h"
+#include "idleworkqueue.h"
+#include "launchstatistics.h"
 
 struct StateManagerPrivate {
     StateManager* instance = nullptr;
@@ -38,6 +42,10 @@ struct StateManagerPrivate {
     HudManager* hudManager;
     OnboardingManager* onboardingManager;
     QuietModeManager* quietModeManager;
+    WindowStateManager* windowStateManager;
+    AnimationClock* animationClock;
+    IdleWorkQueue* idleWorkQueue;
+    LaunchStatistics* launchStatistics;
 };
 
 StateManagerPrivate* StateManager::d = new StateManagerPrivate();
@@ -51,6 +59,10 @@ StateManager::StateManager() : QObject(nullptr) {
     d->hudManager = new HudManager(this);
     d->onboardingManager = new OnboardingManager(this);
     d->quietModeManager = new QuietModeManager(this);
+    d->windowStateManager = new WindowStateManager(this);
+    d->animationClock = new AnimationClock(this);
+    d->idleWorkQueue = new IdleWorkQueue(this);
+    d->launchStatistics = new LaunchStatistics(this);
 }
 
 StateManager* StateManager::instance() {
@@ -89,3 +101,19 @@ OnboardingManager* StateManager::onboardingManager() {
 QuietModeManager* StateManager::quietModeManager() {
     return d->quietModeManager;
 }
+
+WindowStateManager* StateManager::windowStateManager() {
+    return d->windowStateManager;
+}
+
+AnimationClock* StateManager::animationClock() {
+    return d->animationClock;
+}
+
+IdleWorkQueue* StateManager::idleWorkQueue() {
+    return d->idleWorkQueue;
+}
+
+LaunchStatistics* StateManager::launchStatistics() {
+    return d->launchStatistics;
+}
@@ -31,6 +31,10 @@ class LocaleManager;
 class HudManager;
 class OnboardingManager;
 class QuietModeManager;
+class WindowStateManager;
+class AnimationClock;
+class IdleWorkQueue;
+class LaunchStatistics;
 
 struct StateManagerPrivate;
 class LIBTHEDESK_EXPORT StateManager : public QObject {
@@ -46,6 +50,10 @@ class LIBTHEDESK_EXPORT StateManager : public QObject {
         static HudManager* hudManager();
         static OnboardingManager* onboardingManager();
         static QuietModeManager* quietModeManager();
+        static WindowStateManager* windowStateManager();
+        static AnimationClock* animationClock();
+        static IdleWorkQueue* idleWorkQueue();
+        static LaunchStatistics* launchStatistics();
 
     private:
         explicit StateManager();
@@ -84,6 +84,12 @@ void StatusCenterManager::removePane(StatusCenterPane* pane) {
     }
 }
 
+void StatusCenterManager::showPane(StatusCenterPane* pane) {
+    if (!d->panes.contains(pane)) return;
+    emit paneRequested(pane);
+    emit showStatusCenter();
+}
+
 void StatusCenterManager::addSwitch(QuickSwitch* sw) {
     if (!d->switches.contains(sw)) {
         d->switches.append(sw);
@@ -51,6 +51,7 @@ class StatusCenterManager : public QObject {
 
         void addPane(StatusCenterPane* pane, PaneType type = Informational);
         void removePane(StatusCenterPane* pane);
+        void showPane(StatusCenterPane* pane);
 
         void addSwitch(QuickSwitch* sw);
         void removeSwitch(QuickSwitch* sw);
@@ -69,6 +70,7 @@ class StatusCenterManager : public QObject {
 
         void paneAdded(StatusCenterPane* pane, PaneType type);
         void paneRemoved(StatusCenterPane* pane);
+        void paneRequested(StatusCenterPane* pane);
         void switchAdded(QuickSwitch* sw);
         void switchRemoved(QuickSwitch* sw);
 
@@ -78,6 +80,7 @@ class StatusCenterManager : public QObject {
         friend BarWindow;
         friend StatusCenter;
         friend class SystemSettings;
+        friend class SettingsSearchProvider;
         void setIsShowingStatusCenter(bool isShowing);
         void setIsHamburgerMenuRequired(bool isRequired);
         QList<StatusCenterPane*> panes();
@@ -0,0 +1,176 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "windowstatemanager.h"
+
+#include <QApplication>
+#include <QScreen>
+#include <QSet>
+#include <Applications/application.h>
+
+struct WindowStateManagerWindowState {
+    QScreen* maximisedScreen = nullptr;
+    bool fullScreen = false;
+    QString application;
+};
+
+struct WindowStateManagerPrivate {
+    QHash<DesktopWmWindowPtr, WindowStateManagerWindowState> windows;
+
+    QHash<QScreen*, QSet<DesktopWmWindowPtr>> maximisedWindows;
+    QSet<DesktopWmWindowPtr> fullScreenWindows;
+    QHash<QString, QSet<DesktopWmWindowPtr>> applicationWindows;
+};
+
+WindowStateManager::WindowStateManager(QObject* parent) : QObject(parent) {
+    d = new WindowStateManagerPrivate();
+
+    connect(DesktopWm::instance(), &DesktopWm::windowAdded, this, &WindowStateManager::trackWindow);
+    connect(DesktopWm::instance(), &DesktopWm::windowRemoved, this, &WindowStateManager::removeWindow);
+    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
+        trackWindow(window);
+    }
+
+    connect(qApp, &QApplication::screenAdded, this, &WindowStateManager::trackScreen);
+    connect(qApp, &QApplication::screenRemoved, this, [ = ](QScreen* screen) {
+        screen->disconnect(this);
+        d->maximisedWindows.remove(screen);
+        updateAllWindows();
+    });
+    for (QScreen* screen : qApp->screens()) {
+        trackScreen(screen);
+    }
+}
+
+WindowStateManager::~WindowStateManager() {
+    delete d;
+}
+
+bool WindowStateManager::hasMaximisedWindow(QScreen* screen) {
+    return !d->maximisedWindows.value(screen).isEmpty();
+}
+
+bool WindowStateManager::hasFullScreenWindow() {
+    return !d->fullScreenWindows.isEmpty();
+}
+
+QList<DesktopWmWindowPtr> WindowStateManager::windowsForApplication(QString desktopEntry) {
+    return d->applicationWindows.value(desktopEntry).values();
+}
+
+void WindowStateManager::trackWindow(DesktopWmWindowPtr window) {
+    if (d->windows.contains(window)) return;
+    d->windows.insert(window, WindowStateManagerWindowState());
+
+    //Subscribe once; every change goes through updateWindow
+    connect(window, &DesktopWmWindow::geometryChanged, this, [ = ] {
+        updateWindow(window);
+    });
+    connect(window, &DesktopWmWindow::windowStateChanged, this, [ = ] {
+        updateWindow(window);
+    });
+    connect(window, &DesktopWmWindow::applicationChanged, this, [ = ] {
+        updateWindow(window);
+    });
+    updateWindow(window);
+}
+
+void WindowStateManager::removeWindow(DesktopWmWindowPtr window) {
+    if (!d->windows.contains(window)) return;
+    WindowStateManagerWindowState state = d->windows.take(window);
+    window->disconnect(this);
+
+    if (state.maximisedScreen) {
+        d->maximisedWindows[state.maximisedScreen].remove(window);
+        emit maximisedWindowsChanged(state.maximisedScreen);
+    }
+    if (state.fullScreen) {
+        d->fullScreenWindows.remove(window);
+        if (d->fullScreenWindows.isEmpty()) emit fullScreenWindowChanged(false);
+    }
+    if (!state.application.isEmpty()) {
+        d->applicationWindows[state.application].remove(window);
+        if (d->applicationWindows.value(state.application).isEmpty()) d->applicationWindows.remove(state.application);
+        emit applicationWindowsChanged(state.application);
+    }
+}
+
+void WindowStateManager::updateWindow(DesktopWmWindowPtr window) {
+    if (!d->windows.contains(window)) return;
+    WindowStateManagerWindowState& state = d->windows[window];
+
+    QScreen* maximisedScreen = nullptr;
+    if (window->isMaximised() && !window->isMinimized()) {
+        QRect geometry = window->geometry();
+        QScreen* screen = QApplication::screenAt(geometry.center());
+        if (screen && screen->geometry().contains(geometry)) maximisedScreen = screen;
+    }
+    if (maximisedScreen != state.maximisedScreen) {
+        QScreen* oldScreen = state.maximisedScreen;
+        state.maximisedScreen = maximisedScreen;
+        if (oldScreen) {
+            d->maximisedWindows[oldScreen].remove(window);
+            emit maximisedWindowsChanged(oldScreen);
+        }
+        if (maximisedScreen) {
+            d->maximisedWindows[maximisedScreen].insert(window);
+            emit maximisedWindowsChanged(maximisedScreen);
+        }
+    }
+
+    bool fullScreen = window->isFullScreen() && !window->isMinimized();
+    if (fullScreen != state.fullScreen) {
+        bool hadFullScreenWindow = !d->fullScreenWindows.isEmpty();
+        state.fullScreen = fullScreen;
+        if (fullScreen) {
+            d->fullScreenWindows.insert(window);
+        } else {
+            d->fullScreenWindows.remove(window);
+        }
+        if (hadFullScreenWindow != !d->fullScreenWindows.isEmpty()) emit fullScreenWindowChanged(!hadFullScreenWindow);
+    }
+
+    ApplicationPointer app = window->application();
+    QString application = app ? app->desktopEntry() : QString();
+    if (application != state.application) {
+        QString oldApplication = state.application;
+        state.application = application;
+        if (!oldApplication.isEmpty()) {
+            d->applicationWindows[oldApplication].remove(window);
+            if (d->applicationWindows.value(oldApplication).isEmpty()) d->applicationWindows.remove(oldApplication);
+            emit applicationWindowsChanged(oldApplication);
+        }
+        if (!application.isEmpty()) {
+            d->applicationWindows[application].insert(window);
+            emit applicationWindowsChanged(application);
+        }
+    }
+}
+
+void WindowStateManager::updateAllWindows() {
+    for (DesktopWmWindowPtr window : d->windows.keys()) {
+        updateWindow(window);
+    }
+}
+
+void WindowStateManager::trackScreen(QScreen* screen) {
+    //Which screen a window is maximised on depends on the screen layout
+    connect(screen, &QScreen::geometryChanged, this, &WindowStateManager::updateAllWindows);
+    updateAllWindows();
+}
@@ -0,0 +1,54 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef WINDOWSTATEMANAGER_H
+#define WINDOWSTATEMANAGER_H
+
+#include "libthedesk_global.h"
+#include <QObject>
+#include <Wm/desktopwm.h>
+
+class QScreen;
+struct WindowStateManagerPrivate;
+class LIBTHEDESK_EXPORT WindowStateManager : public QObject {
+        Q_OBJECT
+    public:
+        explicit WindowStateManager(QObject* parent = nullptr);
+        ~WindowStateManager();
+
+        bool hasMaximisedWindow(QScreen* screen);
+        bool hasFullScreenWindow();
+        QList<DesktopWmWindowPtr> windowsForApplication(QString desktopEntry);
+
+    signals:
+        void maximisedWindowsChanged(QScreen* screen);
+        void fullScreenWindowChanged(bool hasFullScreenWindow);
+        void applicationWindowsChanged(QString desktopEntry);
+
+    private:
+        WindowStateManagerPrivate* d;
+
+        void trackWindow(DesktopWmWindowPtr window);
+        void removeWindow(DesktopWmWindowPtr window);
+        void updateWindow(DesktopWmWindowPtr window);
+        void updateAllWindows();
+        void trackScreen(QScreen* screen);
+};
+
+#endif // WINDOWSTATEMANAGER_H
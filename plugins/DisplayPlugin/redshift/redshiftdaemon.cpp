@@ -23,6 +23,7 @@
 #include <QTime>
 #include <QAction>
 #include <tsettings.h>
+#include <settingbinding.h>
 #include <statemanager.h>
 #include <statuscentermanager.h>
 #include <quickswitch.h>
@@ -53,6 +54,12 @@ struct RedshiftDaemonPrivate {
     bool updatingState = false;
 
     tSettings settings;
+    SettingBinding<bool>* scheduleRedshift;
+    SettingBinding<bool>* followSunlightCycle;
+    SettingBinding<int>* intensity;
+    SettingBinding<int>* startTime;
+    SettingBinding<int>* endTime;
+
     twMeteorology* meteorologyDaemon;
     QGeoPositionInfoSource* positonSource = nullptr;
 };
@@ -60,9 +67,16 @@ struct RedshiftDaemonPrivate {
 RedshiftDaemon::RedshiftDaemon(QObject* parent) : QObject(parent) {
     d = new RedshiftDaemonPrivate();
 
+    //The state is recalculated every minute, so keep the settings it needs cached
+    d->scheduleRedshift = new SettingBinding<bool>(&d->settings, "Redshift/scheduleRedshift", this);
+    d->followSunlightCycle = new SettingBinding<bool>(&d->settings, "Redshift/followSunlightCycle", this);
+    d->intensity = new SettingBinding<int>(&d->settings, "Redshift/intensity", this);
+    d->startTime = new SettingBinding<int>(&d->settings, "Redshift/startTime", this);
+    d->endTime = new SettingBinding<int>(&d->settings, "Redshift/endTime", this);
+
     d->meteorologyDaemon = new twMeteorology(this);
     connect(d->meteorologyDaemon, &twMeteorology::sunriseSunsetChanged, this, [ = ] {
-        if (d->settings.value("Redshift/followSunlightCycle").toBool()) {
+        if (d->followSunlightCycle->value()) {
             if (!d->meteorologyDaemon->sunset().isNull()) {
                 d->settings.setValue("Redshift/startTime", d->meteorologyDaemon->sunset().msecsSinceStartOfDay());
                 d->settings.setValue("Redshift/endTime", d->meteorologyDaemon->sunrise().msecsSinceStartOfDay());
@@ -94,25 +108,20 @@ RedshiftDaemon::RedshiftDaemon(QObject* parent) : QObject(parent) {
     d->redshiftStateTimer = new QTimer();
     d->redshiftStateTimer->setInterval(60000);
     connect(d->redshiftStateTimer, &QTimer::timeout, this, &RedshiftDaemon::updateRedshiftState);
-    if (d->settings.value("Redshift/scheduleRedshift").toBool()) d->redshiftStateTimer->start();
-
-    connect(&d->settings, &tSettings::settingChanged, this, [ = ](QString key, QVariant value) {
-        if (key.startsWith("Redshift/")) {
-            //Turn on/off the Redshift timer
-            if (key == "Redshift/scheduleRedshift") {
-                if (value.toBool()) {
-                    d->redshiftStateTimer->start();
-                } else {
-                    d->redshiftStateTimer->stop();
-                }
+    if (d->scheduleRedshift->value()) d->redshiftStateTimer->start();
 
-                //Recalculate the Redshift state
-                this->updateRedshiftState();
-            } else if (key == "Redshift/followSunlightCycle") {
-                updateSunlightCycleState();
-            }
+    connect(d->scheduleRedshift, &SettingBindingBase::changed, this, [ = ] {
+        //Turn on/off the Redshift timer
+        if (d->scheduleRedshift->value()) {
+            d->redshiftStateTimer->start();
+        } else {
+            d->redshiftStateTimer->stop();
         }
+
+        //Recalculate the Redshift state
+        this->updateRedshiftState();
     });
+    connect(d->followSunlightCycle, &SettingBindingBase::changed, this, &RedshiftDaemon::updateSunlightCycleState);
 
     this->updateRedshiftState();
     this->updateSunlightCycleState();
@@ -129,12 +138,12 @@ void RedshiftDaemon::updateRedshiftState() {
     d->updatingState = true;
     int time = QTime::currentTime().msecsSinceStartOfDay();
     const int transitionTime = 1800000; //half an hour
-    bool scheduled = d->settings.value("Redshift/scheduleRedshift").toBool();
-    int intensity = d->settings.value("Redshift/intensity").toInt();
+    bool scheduled = d->scheduleRedshift->value();
+    int intensity = d->intensity->value();
 
     //Time right in the middle of the transition time
-    int startTime = d->settings.value("Redshift/startTime").toInt();
-    int endTime = d->settings.value("Redshift/endTime").toInt();
+    int startTime = d->startTime->value();
+    int endTime = d->endTime->value();
     bool scheduledShouldBeOnMidTransitionTime = false;
 
     //First/last time when Redshift should be fully off
@@ -229,7 +238,7 @@ void RedshiftDaemon::updateRedshiftState() {
 }
 
 void RedshiftDaemon::updateSunlightCycleState() {
-    if (d->settings.value("Redshift/followSunlightCycle").toBool()) {
+    if (d->followSunlightCycle->value()) {
         if (!d->positonSource) {
             d->positonSource = QGeoPositionInfoSource::createDefaultSource(this);
             d->positonSource->setPreferredPositioningMethods(QGeoPositionInfoSource::NonSatellitePositioningMethods);
@@ -18,7 +18,7 @@ packagesExist(x11) {
 
 
     packagesExist(xi) : packagesExist(xorg-libinput) {
-        PKGCONFIG += xi xorg-libinput
+        PKGCONFIG += xi xorg-libinput xcb
         DEFINES += HAVE_XI
         message("Building with XInput support");
 
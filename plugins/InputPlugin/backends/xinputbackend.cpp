@@ -20,7 +20,13 @@
 #include "xinputbackend.h"
 
 #include <QVariant>
+#include <QTimer>
+#include <QHash>
+#include <QMap>
+#include <QCoreApplication>
+#include <cstring>
 #include <QX11Info>
+#include <xcb/xcb.h>
 #include <libinput-properties.h>
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
@@ -29,94 +35,246 @@
 
 #undef Bool
 
+struct XInputDeviceProperty {
+    Atom type;
+    int format;
+    unsigned long count;
+};
+
+struct XInputDevice {
+    int id;
+    int kind;
+
+    //Property formats are fixed for the lifetime of the device, so only look them up once
+    QHash<Atom, XInputDeviceProperty> properties;
+};
+
+struct XInputPendingWrite {
+    QByteArray atom;
+    QVariantList value;
+    int writeFor;
+};
+
+struct XInputBackendPrivate {
+    QHash<QByteArray, Atom> atoms;
+    QList<XInputDevice> devices;
+    bool devicesValid = false;
+
+    //Keyed on atom and device class so that mouse and touchpad writes of the same property don't collide
+    QMap<QByteArray, XInputPendingWrite> pendingWrites;
+    QMap<QByteArray, XInputPendingWrite> appliedWrites;
+    QTimer* flushTimer;
+
+    int xiOpcode = -1;
+};
+
 XInputBackend::XInputBackend(QObject* parent) : SettingsBackend(parent) {
+    d = new XInputBackendPrivate();
+
+    //Coalesce writes so that a burst of changes only touches the server once per frame
+    d->flushTimer = new QTimer(this);
+    d->flushTimer->setSingleShot(true);
+    d->flushTimer->setInterval(16);
+    connect(d->flushTimer, &QTimer::timeout, this, &XInputBackend::flushXiSettings);
+
+    //Listen for hierarchy changes so we know when devices are plugged in or removed
+    int event, error;
+    if (XQueryExtension(QX11Info::display(), "XInputExtension", &d->xiOpcode, &event, &error)) {
+        Window root = DefaultRootWindow(QX11Info::display());
+
+        //Qt already selects XI2 events on the root window, so add to its mask instead of replacing it
+        unsigned char mask[XIMaskLen(XI_LASTEVENT)] = {0};
+        int maskCount;
+        XIEventMask* existingMasks = XIGetSelectedEvents(QX11Info::display(), root, &maskCount);
+        if (existingMasks != nullptr) {
+            for (int i = 0; i < maskCount; i++) {
+                if (existingMasks[i].deviceid == XIAllDevices) {
+                    memcpy(mask, existingMasks[i].mask, qMin(static_cast<size_t>(existingMasks[i].mask_len), sizeof(mask)));
+                }
+            }
+            XFree(existingMasks);
+        }
+        XISetMask(mask, XI_HierarchyChanged);
+
+        XIEventMask eventMask;
+        eventMask.deviceid = XIAllDevices;
+        eventMask.mask_len = sizeof(mask);
+        eventMask.mask = mask;
+        XISelectEvents(QX11Info::display(), root, &eventMask, 1);
+        XFlush(QX11Info::display());
 
+        QCoreApplication::instance()->installNativeEventFilter(this);
+    }
+}
+
+XInputBackend::~XInputBackend() {
+    QCoreApplication::instance()->removeNativeEventFilter(this);
+    delete d;
 }
 
 void XInputBackend::writeXiSetting(const char* atom, QVariantList value, WriteFor writeFor) {
-    int devices;
-    XDeviceInfo* info = XListInputDevices(QX11Info::display(), &devices);
-    if (info == nullptr) return;
+    if (value.isEmpty()) return;
 
-    Atom mouseAtom = XInternAtom(QX11Info::display(), XI_MOUSE, True);
-    Atom touchpadAtom = XInternAtom(QX11Info::display(), XI_TOUCHPAD, True);
-    Atom trackballAtom = XInternAtom(QX11Info::display(), XI_TRACKBALL, True);
-    for (int i = 0; i < devices; i++) {
-        XDeviceInfo* d = info + i;
-        if ((d->type == mouseAtom && writeFor & Mice)
-            || (d->type == touchpadAtom && writeFor & Touchpads)
-            || (d->type == trackballAtom && writeFor & Mice)) {
-            Atom valAtom = XInternAtom(QX11Info::display(), atom, True);
-            Atom type;
-            if (value.first().type() == QVariant::Bool || value.first().type() == QVariant::Int || value.first().type() == QVariant::Char) {
-                type = XA_INTEGER;
-            } else if (value.first().type() == QVariant::Double) {
-                type = XInternAtom(QX11Info::display(), "FLOAT", False);
-            } else {
-                return;
-            }
+    XInputPendingWrite write;
+    write.atom = atom;
+    write.value = value;
+    write.writeFor = writeFor;
+
+    QByteArray key = write.atom + "/" + QByteArray::number(writeFor);
+    d->pendingWrites.insert(key, write);
 
-            Atom typeReturn;
-            int formatReturn;
-            unsigned long itemCount;
-            unsigned long bytesAfter;
-            unsigned char* data = nullptr;
-            Status s = XIGetProperty(QX11Info::display(), d->id, valAtom, 0, 32, False, type, &typeReturn, &formatReturn, &itemCount, &bytesAfter, &data);
-            if (s != Success) continue;
-
-            if (typeReturn != type || data == nullptr || itemCount != value.count()) {
-                if (data != nullptr) {
-                    XFree(data);
+    //Remember this so it can be applied to devices that get plugged in later
+    d->appliedWrites.insert(key, write);
+
+    if (!d->flushTimer->isActive()) d->flushTimer->start();
+}
+
+void XInputBackend::flushXiSettings() {
+    if (d->pendingWrites.isEmpty()) return;
+    if (!d->devicesValid) updateDevices();
+
+    Atom floatAtom = atom("FLOAT", false);
+    for (const XInputPendingWrite& write : qAsConst(d->pendingWrites)) {
+        QVariant::Type valueType = write.value.first().type();
+        Atom type;
+        int format;
+        if (valueType == QVariant::Bool || valueType == QVariant::Char) {
+            type = XA_INTEGER;
+            format = 8;
+        } else if (valueType == QVariant::Int) {
+            type = XA_INTEGER;
+            format = 32;
+        } else if (valueType == QVariant::Double) {
+            type = floatAtom;
+            format = 32;
+        } else {
+            continue;
+        }
+
+        Atom valAtom = atom(write.atom.constData());
+        if (valAtom == None) continue;
+
+        for (XInputDevice& device : d->devices) {
+            if (!(device.kind & write.writeFor)) continue;
+
+            if (!device.properties.contains(valAtom)) {
+                Atom typeReturn;
+                int formatReturn;
+                unsigned long itemCount;
+                unsigned long bytesAfter;
+                unsigned char* data = nullptr;
+                Status s = XIGetProperty(QX11Info::display(), device.id, valAtom, 0, 32, False, AnyPropertyType, &typeReturn, &formatReturn, &itemCount, &bytesAfter, &data);
+                if (data != nullptr) XFree(data);
+
+                XInputDeviceProperty property;
+                if (s == Success) {
+                    property.type = typeReturn;
+                    property.format = formatReturn;
+                    property.count = itemCount;
+                } else {
+                    property.type = None;
+                    property.format = 0;
+                    property.count = 0;
                 }
-                continue;
+                device.properties.insert(valAtom, property);
             }
 
-            if (value.first().type() == QVariant::Bool && formatReturn != 8) {
-                XFree(data);
-                continue;
-            } else if (value.first().type() == QVariant::Double && formatReturn != 32) {
-                XFree(data);
-                continue;
-            } else if (value.first().type() == QVariant::Char && formatReturn != 8) {
-                XFree(data);
-                continue;
-            } else if (value.first().type() == QVariant::Int && formatReturn != 32) {
-                XFree(data);
-                continue;
-            }
+            XInputDeviceProperty property = device.properties.value(valAtom);
+            if (property.type != type || property.format != format || property.count != static_cast<unsigned long>(write.value.count())) continue;
 
-            if (value.first().type() == QVariant::Bool) {
+            if (valueType == QVariant::Bool) {
                 unsigned char v[64];
-                for (int i = 0; i < value.count(); i++) {
-                    v[i] = value.at(i).toBool() ? 1 : 0;
+                for (int i = 0; i < write.value.count(); i++) {
+                    v[i] = write.value.at(i).toBool() ? 1 : 0;
                 }
-                XIChangeProperty(QX11Info::display(), d->id, valAtom, type, 8, XIPropModeReplace, v, value.count());
-            } else if (value.first().type() == QVariant::Double) {
+                XIChangeProperty(QX11Info::display(), device.id, valAtom, type, 8, XIPropModeReplace, v, write.value.count());
+            } else if (valueType == QVariant::Double) {
                 float v[64];
-                for (int i = 0; i < value.count(); i++) {
-                    v[i] = static_cast<float>(value.at(i).toDouble());
+                for (int i = 0; i < write.value.count(); i++) {
+                    v[i] = static_cast<float>(write.value.at(i).toDouble());
                 }
-                XIChangeProperty(QX11Info::display(), d->id, valAtom, type, 32, XIPropModeReplace, reinterpret_cast<unsigned char*>(v), value.count());
-            } else if (value.first().type() == QVariant::Char) {
+                XIChangeProperty(QX11Info::display(), device.id, valAtom, type, 32, XIPropModeReplace, reinterpret_cast<unsigned char*>(v), write.value.count());
+            } else if (valueType == QVariant::Char) {
                 unsigned char v[64];
-                for (int i = 0; i < value.count(); i++) {
-                    v[i] = value.at(i).toChar().toLatin1();
+                for (int i = 0; i < write.value.count(); i++) {
+                    v[i] = write.value.at(i).toChar().toLatin1();
                 }
-                XIChangeProperty(QX11Info::display(), d->id, valAtom, type, 8, XIPropModeReplace, v, value.count());
-            } else if (value.first().type() == QVariant::Int) {
+                XIChangeProperty(QX11Info::display(), device.id, valAtom, type, 8, XIPropModeReplace, v, write.value.count());
+            } else if (valueType == QVariant::Int) {
                 int v[64];
-                for (int i = 0; i < value.count(); i++) {
-                    v[i] = value.at(i).toInt();
+                for (int i = 0; i < write.value.count(); i++) {
+                    v[i] = write.value.at(i).toInt();
                 }
-                XIChangeProperty(QX11Info::display(), d->id, valAtom, type, 32, XIPropModeReplace, reinterpret_cast<unsigned char*>(v), value.count());
+                XIChangeProperty(QX11Info::display(), device.id, valAtom, type, 32, XIPropModeReplace, reinterpret_cast<unsigned char*>(v), write.value.count());
             }
+        }
+    }
+
+    d->pendingWrites.clear();
+    XFlush(QX11Info::display());
+}
+
+void XInputBackend::updateDevices() {
+    d->devices.clear();
+    d->devicesValid = true;
+
+    int devices;
+    XDeviceInfo* info = XListInputDevices(QX11Info::display(), &devices);
+    if (info == nullptr) return;
 
-            XFree(data);
+    Atom mouseAtom = atom(XI_MOUSE);
+    Atom touchpadAtom = atom(XI_TOUCHPAD);
+    Atom trackballAtom = atom(XI_TRACKBALL);
+    for (int i = 0; i < devices; i++) {
+        XDeviceInfo* deviceInfo = info + i;
+
+        XInputDevice device;
+        device.id = static_cast<int>(deviceInfo->id);
+        if (deviceInfo->type == None) {
+            continue;
+        } else if (deviceInfo->type == mouseAtom || deviceInfo->type == trackballAtom) {
+            device.kind = Mice;
+        } else if (deviceInfo->type == touchpadAtom) {
+            device.kind = Touchpads;
+        } else {
+            continue;
         }
+        d->devices.append(device);
     }
     XFreeDeviceList(info);
 }
 
+unsigned long XInputBackend::atom(const char* name, bool onlyIfExists) {
+    QByteArray key(name);
+    if (d->atoms.contains(key)) return d->atoms.value(key);
+
+    Atom atom = XInternAtom(QX11Info::display(), name, onlyIfExists);
+
+    //Don't cache a missing atom; it may be created later by a driver
+    if (atom != None) d->atoms.insert(key, atom);
+    return atom;
+}
+
+bool XInputBackend::nativeEventFilter(const QByteArray& eventType, void* message, long* result) {
+    Q_UNUSED(result);
+    if (eventType != "xcb_generic_event_t") return false;
+
+    xcb_generic_event_t* event = static_cast<xcb_generic_event_t*>(message);
+    if ((event->response_type & ~0x80) != XCB_GE_GENERIC) return false;
+
+    xcb_ge_generic_event_t* geEvent = reinterpret_cast<xcb_ge_generic_event_t*>(event);
+    if (geEvent->extension != d->xiOpcode || geEvent->event_type != XI_HierarchyChanged) return false;
+
+    //Devices have changed; forget what we know and reapply every setting to the new set of devices
+    d->devicesValid = false;
+    for (auto i = d->appliedWrites.constBegin(); i != d->appliedWrites.constEnd(); i++) {
+        d->pendingWrites.insert(i.key(), i.value());
+    }
+    if (!d->pendingWrites.isEmpty() && !d->flushTimer->isActive()) d->flushTimer->start();
+
+    return false;
+}
+
 void XInputBackend::setPrimaryMouseButton(MousePrimaryButton button) {
     writeXiSetting(LIBINPUT_PROP_LEFT_HANDED, {button == RightMouseButton}, Mice);
 }
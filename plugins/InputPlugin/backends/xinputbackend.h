@@ -21,11 +21,14 @@
 #define XINPUTBACKEND_H
 
 #include "settingsbackend.h"
+#include <QAbstractNativeEventFilter>
 
-class XInputBackend : public SettingsBackend {
+struct XInputBackendPrivate;
+class XInputBackend : public SettingsBackend, public QAbstractNativeEventFilter {
         Q_OBJECT
     public:
         explicit XInputBackend(QObject* parent = nullptr);
+        ~XInputBackend();
 
     signals:
 
@@ -36,13 +39,22 @@ class XInputBackend : public SettingsBackend {
             AllDevices = Mice | Touchpads
         };
 
+        XInputBackendPrivate* d;
+
         void writeXiSetting(const char* atom, QVariantList value, WriteFor writeFor = AllDevices);
+        void flushXiSettings();
+        void updateDevices();
+        unsigned long atom(const char* name, bool onlyIfExists = true);
 
         // SettingsBackend interface
     public:
         void setPrimaryMouseButton(MousePrimaryButton button);
         void setPrimaryTouchpadButton(MousePrimaryButton button);
         void setTapToClick(bool tapToClick);
+
+        // QAbstractNativeEventFilter interface
+    public:
+        bool nativeEventFilter(const QByteArray& eventType, void* message, long* result);
 };
 
 #endif // XINPUTBACKEND_H
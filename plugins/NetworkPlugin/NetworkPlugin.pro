@@ -47,7 +47,9 @@ SOURCES += \
     models/wirelessaccesspointsmodel.cpp \
     models/wirelessconnectionlistmodel.cpp \
     models/wirelessnetworklistdelegate.cpp \
+    modemcache.cpp \
     plugin.cpp \
+    search/networksearchprovider.cpp \
     statusCenter/connectionEditor/connectioneditorpane.cpp \
     statusCenter/connectionEditor/ipv4connectioneditorpane.cpp \
     statusCenter/connectionEditor/networkconnectioneditor.cpp \
@@ -80,7 +82,9 @@ HEADERS += \
     models/wirelessaccesspointsmodel.h \
     models/wirelessconnectionlistmodel.h \
     models/wirelessnetworklistdelegate.h \
+    modemcache.h \
     plugin.h \
+    search/networksearchprovider.h \
     statusCenter/connectionEditor/connectioneditorpane.h \
     statusCenter/connectionEditor/ipv4connectioneditorpane.h \
     statusCenter/connectionEditor/networkconnectioneditor.h \
@@ -19,7 +19,7 @@
  * *************************************/
 #include "common.h"
 
-#include <Modem3Gpp>
+#include "modemcache.h"
 
 QString Common::stateChangeReasonToString(NetworkManager::Device::StateChangeReason reason) {
 
@@ -187,14 +187,5 @@ QString Common::iconForSignalStrength(int strength, Common::WirelessType type) {
 }
 
 QString Common::operatorNameForModem(ModemManager::ModemDevice::Ptr device) {
-    if (device->sim() && !device->sim()->operatorName().isEmpty()) {
-        return device->sim()->operatorName();
-    }
-
-    ModemManager::Modem3gpp::Ptr modem3gpp(new ModemManager::Modem3gpp(device->uni()));
-    if (!modem3gpp->operatorName().isEmpty()) {
-        return modem3gpp->operatorName();
-    }
-
-    return tr("Cellular");
+    return ModemCache::instance()->operatorName(device);
 }
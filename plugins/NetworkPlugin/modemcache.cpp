@@ -0,0 +1,172 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "modemcache.h"
+
+#include <QHash>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusArgument>
+#include <QDBusVariant>
+#include <Manager>
+#include <Modem3Gpp>
+#include <Sim>
+#include "common.h"
+
+struct ModemCacheEntry {
+    QString uni;
+    ModemManager::ModemDevice::Ptr device;
+    ModemManager::Modem3gpp::Ptr modem3gpp;
+
+    QString operatorName;
+    int signalQuality = 0;
+    MMModemLock unlockRequired = MM_MODEM_LOCK_UNKNOWN;
+    MMModem3gppRegistrationState registrationState = MM_MODEM_3GPP_REGISTRATION_STATE_UNKNOWN;
+    ModemManager::UnlockRetriesMap unlockRetries;
+};
+
+struct ModemCachePrivate {
+    static ModemCache* instance;
+    QHash<QString, ModemCacheEntry*> entries;
+};
+
+ModemCache* ModemCachePrivate::instance = nullptr;
+
+ModemCache::ModemCache(QObject* parent) : QObject(parent) {
+    d = new ModemCachePrivate();
+
+    connect(ModemManager::notifier(), &ModemManager::Notifier::modemRemoved, this, &ModemCache::removeEntry);
+}
+
+ModemCache::~ModemCache() {
+    qDeleteAll(d->entries);
+    delete d;
+}
+
+ModemCache* ModemCache::instance() {
+    if (ModemCachePrivate::instance == nullptr) ModemCachePrivate::instance = new ModemCache();
+    return ModemCachePrivate::instance;
+}
+
+QString ModemCache::operatorName(ModemManager::ModemDevice::Ptr device) {
+    QString name = entry(device)->operatorName;
+    if (name.isEmpty()) return Common::tr("Cellular");
+    return name;
+}
+
+int ModemCache::signalQuality(ModemManager::ModemDevice::Ptr device) {
+    return entry(device)->signalQuality;
+}
+
+MMModemLock ModemCache::unlockRequired(ModemManager::ModemDevice::Ptr device) {
+    return entry(device)->unlockRequired;
+}
+
+MMModem3gppRegistrationState ModemCache::registrationState(ModemManager::ModemDevice::Ptr device) {
+    return entry(device)->registrationState;
+}
+
+ModemManager::UnlockRetriesMap ModemCache::unlockRetries(ModemManager::ModemDevice::Ptr device) {
+    return entry(device)->unlockRetries;
+}
+
+void ModemCache::refreshUnlockRetries(ModemManager::ModemDevice::Ptr device) {
+    QString uni = entry(device)->uni;
+
+    //Read UnlockRetries directly; ModemManagerQt doesn't always keep this property up to date
+    QDBusMessage unlockRetriesMessage = QDBusMessage::createMethodCall("org.freedesktop.ModemManager1", uni, "org.freedesktop.DBus.Properties", "Get");
+    unlockRetriesMessage.setArguments({"org.freedesktop.ModemManager1.Modem", "UnlockRetries"});
+
+    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(unlockRetriesMessage));
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        watcher->deleteLater();
+        if (watcher->isError()) return;
+
+        //The modem may have gone away while we were waiting
+        ModemCacheEntry* e = d->entries.value(uni);
+        if (!e) return;
+
+        ModemManager::UnlockRetriesMap retries;
+        QDBusArgument unlockRetriesArg = watcher->reply().arguments().first().value<QDBusVariant>().variant().value<QDBusArgument>();
+        unlockRetriesArg >> retries;
+
+        e->unlockRetries = retries;
+        emit modemChanged(uni);
+    });
+}
+
+ModemCacheEntry* ModemCache::entry(ModemManager::ModemDevice::Ptr device) {
+    QString uni = device->uni();
+    if (d->entries.contains(uni)) return d->entries.value(uni);
+
+    ModemCacheEntry* e = new ModemCacheEntry();
+    e->uni = uni;
+    e->device = device;
+    e->modem3gpp = ModemManager::Modem3gpp::Ptr(new ModemManager::Modem3gpp(uni));
+    d->entries.insert(uni, e);
+
+    ModemManager::Modem::Ptr modem = device->modemInterface();
+    e->signalQuality = modem->signalQuality().signal;
+    e->unlockRequired = modem->unlockRequired();
+    e->registrationState = e->modem3gpp->registrationState();
+    updateOperatorName(e);
+
+    connect(modem.data(), &ModemManager::Modem::signalQualityChanged, this, [ = ](ModemManager::SignalQualityPair signalQuality) {
+        e->signalQuality = signalQuality.signal;
+        emit modemChanged(uni);
+    });
+    connect(modem.data(), &ModemManager::Modem::unlockRequiredChanged, this, [ = ](MMModemLock unlockRequired) {
+        e->unlockRequired = unlockRequired;
+        refreshUnlockRetries(device);
+        emit modemChanged(uni);
+    });
+    connect(e->modem3gpp.data(), &ModemManager::Modem3gpp::registrationStateChanged, this, [ = ](MMModem3gppRegistrationState registrationState) {
+        e->registrationState = registrationState;
+        emit modemChanged(uni);
+    });
+    connect(e->modem3gpp.data(), &ModemManager::Modem3gpp::operatorNameChanged, this, [ = ] {
+        updateOperatorName(e);
+        emit modemChanged(uni);
+    });
+    connect(modem.data(), &ModemManager::Modem::simPathChanged, this, [ = ] {
+        updateOperatorName(e);
+        emit modemChanged(uni);
+    });
+
+    refreshUnlockRetries(device);
+    return e;
+}
+
+void ModemCache::removeEntry(QString uni) {
+    ModemCacheEntry* e = d->entries.take(uni);
+    if (!e) return;
+
+    e->device->modemInterface()->disconnect(this);
+    e->modem3gpp->disconnect(this);
+    delete e;
+}
+
+void ModemCache::updateOperatorName(ModemCacheEntry* entry) {
+    if (entry->device->sim() && !entry->device->sim()->operatorName().isEmpty()) {
+        entry->operatorName = entry->device->sim()->operatorName();
+    } else {
+        entry->operatorName = entry->modem3gpp->operatorName();
+    }
+}
@@ -0,0 +1,55 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef MODEMCACHE_H
+#define MODEMCACHE_H
+
+#include <QObject>
+#include <ModemDevice>
+#include <Modem>
+
+struct ModemCacheEntry;
+struct ModemCachePrivate;
+class ModemCache : public QObject {
+        Q_OBJECT
+    public:
+        static ModemCache* instance();
+
+        QString operatorName(ModemManager::ModemDevice::Ptr device);
+        int signalQuality(ModemManager::ModemDevice::Ptr device);
+        MMModemLock unlockRequired(ModemManager::ModemDevice::Ptr device);
+        MMModem3gppRegistrationState registrationState(ModemManager::ModemDevice::Ptr device);
+        ModemManager::UnlockRetriesMap unlockRetries(ModemManager::ModemDevice::Ptr device);
+
+        void refreshUnlockRetries(ModemManager::ModemDevice::Ptr device);
+
+    signals:
+        void modemChanged(QString uni);
+
+    private:
+        explicit ModemCache(QObject* parent = nullptr);
+        ~ModemCache();
+        ModemCachePrivate* d;
+
+        ModemCacheEntry* entry(ModemManager::ModemDevice::Ptr device);
+        void removeEntry(QString uni);
+        void updateOperatorName(ModemCacheEntry* entry);
+};
+
+#endif // MODEMCACHE_H
@@ -22,6 +22,7 @@
 #include <QDebug>
 #include <statemanager.h>
 #include <statuscentermanager.h>
+#include <gatewaymanager.h>
 #include <localemanager.h>
 #include <QApplication>
 #include <QDir>
@@ -31,6 +32,7 @@
 #include "tsettings.h"
 
 #include "statusCenter/networkstatuscenterpane.h"
+#include "search/networksearchprovider.h"
 
 struct PluginPrivate {
     int translationSet;
@@ -38,6 +40,7 @@ struct PluginPrivate {
     NetworkStatusCenterPane* statusCenterPane;
     NetworkChunk* chunk;
     SwitchManager* switches;
+    NetworkSearchProvider* searchProvider;
 };
 
 Plugin::Plugin() {
@@ -62,9 +65,14 @@ void Plugin::activate() {
 
     d->statusCenterPane = new NetworkStatusCenterPane(d->switches);
     StateManager::statusCenterManager()->addPane(d->statusCenterPane);
+
+    d->searchProvider = new NetworkSearchProvider(d->statusCenterPane);
+    StateManager::gatewayManager()->addSearchProvider(d->searchProvider);
 }
 
 void Plugin::deactivate() {
+    StateManager::gatewayManager()->removeSearchProvider(d->searchProvider);
+    d->searchProvider->deleteLater();
     d->switches->deleteLater();
     d->chunk->deleteLater();
     StateManager::statusCenterManager()->removePane(d->statusCenterPane);
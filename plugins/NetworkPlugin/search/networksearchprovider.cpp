@@ -0,0 +1,97 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "networksearchprovider.h"
+
+#include <QPointer>
+#include <statemanager.h>
+#include <statuscentermanager.h>
+#include <statuscenterpane.h>
+
+#include <NetworkManagerQt/Manager>
+#include <NetworkManagerQt/Settings>
+
+struct NetworkSearchProviderPrivate {
+    QPointer<StatusCenterPane> networkPane;
+};
+
+NetworkSearchProvider::NetworkSearchProvider(StatusCenterPane* networkPane, QObject* parent) : SearchProvider(parent) {
+    d = new NetworkSearchProviderPrivate();
+    d->networkPane = networkPane;
+}
+
+NetworkSearchProvider::~NetworkSearchProvider() {
+    delete d;
+}
+
+QString NetworkSearchProvider::name() {
+    return tr("Network Connections");
+}
+
+void NetworkSearchProvider::search(SearchQueryPtr query) {
+    QStringList activeConnections;
+    for (NetworkManager::ActiveConnection::Ptr connection : NetworkManager::activeConnections()) {
+        if (connection->connection()) activeConnections.append(connection->connection()->path());
+    }
+
+    QList<SearchResult> results;
+    for (NetworkManager::Device::Ptr device : NetworkManager::networkInterfaces()) {
+        for (NetworkManager::Connection::Ptr connection : device->availableConnections()) {
+            NetworkManager::ConnectionSettings::Ptr settings = connection->settings();
+            if (!settings->id().contains(query->query(), Qt::CaseInsensitive)) continue;
+
+            SearchResult result;
+            result.title = settings->id();
+
+            switch (settings->connectionType()) {
+                case NetworkManager::ConnectionSettings::Wireless:
+                    result.icon = QIcon::fromTheme("network-wireless");
+                    break;
+                case NetworkManager::ConnectionSettings::Wired:
+                    result.icon = QIcon::fromTheme("network-wired");
+                    break;
+                case NetworkManager::ConnectionSettings::Gsm:
+                    result.icon = QIcon::fromTheme("network-cellular");
+                    break;
+                default:
+                    result.icon = QIcon::fromTheme("network-connect");
+            }
+
+            if (activeConnections.contains(connection->path())) {
+                //Already connected, so show the connection's details instead
+                result.description = tr("Connected");
+                QPointer<StatusCenterPane> networkPane = d->networkPane;
+                result.activate = [ = ] {
+                    if (networkPane) StateManager::statusCenterManager()->showPane(networkPane);
+                };
+            } else {
+                result.description = tr("Connect on %1").arg(device->interfaceName());
+                QString connectionPath = connection->path();
+                QString devicePath = device->uni();
+                result.activate = [ = ] {
+                    NetworkManager::activateConnection(connectionPath, devicePath, "");
+                };
+            }
+            results.append(result);
+        }
+    }
+
+    query->addResults(results);
+    query->finish();
+}
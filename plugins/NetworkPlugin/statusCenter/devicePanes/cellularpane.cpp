@@ -32,6 +32,7 @@
 #include "../popovers/unlockmodempopover.h"
 #include "../popovers/simsettingspopover.h"
 #include "common.h"
+#include "modemcache.h"
 
 #include <icontextchunk.h>
 #include <actionquickwidget.h>
@@ -42,13 +43,11 @@
 #include <Manager>
 #include <Modem>
 #include <Sim>
-#include <Modem3Gpp>
 
 struct CellularPanePrivate {
     QListWidgetItem* item;
     NetworkManager::ModemDevice::Ptr device;
     ModemManager::ModemDevice::Ptr modem;
-    ModemManager::Modem3gpp::Ptr modem3gpp;
 
     IconTextChunk* chunk;
 
@@ -81,7 +80,6 @@ CellularPane::CellularPane(QString uni, QWidget* parent) :
     d->item = new QListWidgetItem();
     d->device = NetworkManager::findNetworkInterface(uni).staticCast<NetworkManager::ModemDevice>();
     d->modem = ModemManager::findModemDevice(d->device->udi());
-    d->modem3gpp = ModemManager::Modem3gpp::Ptr(new ModemManager::Modem3gpp(d->device->udi()));
 
     d->unlockSimAction = new QAction(this);
     d->unlockSimAction->setVisible(false);
@@ -153,10 +151,10 @@ CellularPane::CellularPane(QString uni, QWidget* parent) :
         }
     });
 
-    connect(d->modem->modemInterface().data(), &ModemManager::Modem::signalQualityChanged, this, &CellularPane::updateState);
     connect(d->modem->modemInterface().data(), &ModemManager::Modem::currentModesChanged, this, &CellularPane::updateState);
-    connect(d->modem->modemInterface().data(), &ModemManager::Modem::unlockRequiredChanged, this, &CellularPane::updateState);
-    connect(d->modem3gpp.data(), &ModemManager::Modem3gpp::registrationStateChanged, this, &CellularPane::updateState);
+    connect(ModemCache::instance(), &ModemCache::modemChanged, this, [ = ](QString uni) {
+        if (uni == d->modem->uni()) updateState();
+    });
 
     StateManager::barManager()->addChunk(d->chunk);
 }
@@ -169,8 +167,9 @@ CellularPane::~CellularPane() {
 }
 
 void CellularPane::updateState() {
-    QIcon signalIcon = QIcon::fromTheme(Common::iconForSignalStrength(d->modem->modemInterface()->signalQuality().signal, Common::Cellular));
-    QIcon signalErrorIcon = QIcon::fromTheme(Common::iconForSignalStrength(d->modem->modemInterface()->signalQuality().signal, Common::CellularError));
+    int signalQuality = ModemCache::instance()->signalQuality(d->modem);
+    QIcon signalIcon = QIcon::fromTheme(Common::iconForSignalStrength(signalQuality, Common::Cellular));
+    QIcon signalErrorIcon = QIcon::fromTheme(Common::iconForSignalStrength(signalQuality, Common::CellularError));
     ui->deviceIcon->setPixmap(QIcon::fromTheme("computer").pixmap(SC_DPI_T(QSize(96, 96), QSize)));
     ui->routerIcon->setPixmap(signalIcon.pixmap(SC_DPI_T(QSize(96, 96), QSize)));
     ui->routerName->setText(this->operatorName());
@@ -301,7 +300,7 @@ void CellularPane::updateState() {
                     chunkParts.append("1X");
                 }
 
-            MMModem3gppRegistrationState modem3gppRegistration = d->modem3gpp->registrationState();
+            MMModem3gppRegistrationState modem3gppRegistration = ModemCache::instance()->registrationState(d->modem);
             if (modem3gppRegistration == MM_MODEM_3GPP_REGISTRATION_STATE_ROAMING ||
                 modem3gppRegistration == MM_MODEM_3GPP_REGISTRATION_STATE_ROAMING_SMS_ONLY ||
                 modem3gppRegistration == MM_MODEM_3GPP_REGISTRATION_STATE_ROAMING_CSFB_NOT_PREFERRED) {
@@ -311,8 +310,7 @@ void CellularPane::updateState() {
             break;
     }
 
-    MMModemLock unlockRequired = d->modem->modemInterface()->unlockRequired();
-    ModemManager::UnlockRetriesMap retries = d->modem->modemInterface()->unlockRetries();
+    MMModemLock unlockRequired = ModemCache::instance()->unlockRequired(d->modem);
     switch (unlockRequired) {
         case MM_MODEM_LOCK_SIM_PIN: {
             ui->unlockModemButton->setText(tr("Enter SIM PIN"));
@@ -21,6 +21,7 @@
 #include "ui_simsettingspopover.h"
 
 #include <common.h>
+#include "modemcache.h"
 #include <ttoast.h>
 
 struct SimSettingsPopoverPrivate {
@@ -41,6 +42,10 @@ SimSettingsPopover::SimSettingsPopover(ModemManager::ModemDevice::Ptr modem, QWi
     d = new SimSettingsPopoverPrivate();
     d->modem = modem;
 
+    connect(ModemCache::instance(), &ModemCache::modemChanged, this, [ = ](QString uni) {
+        if (uni == d->modem->uni()) updateRetryCount();
+    });
+
     ui->titleLabel->setBackButtonShown(true);
     ui->currentPinTitleLabel->setBackButtonShown(true);
     ui->changeSimPinTitleLabel->setBackButtonShown(true);
@@ -127,19 +132,20 @@ void SimSettingsPopover::on_currentPinTitleLabel_backButtonClicked() {
 }
 
 void SimSettingsPopover::prepareCurrentPinPage() {
-    ModemManager::UnlockRetriesMap retries;
-
-    QDBusMessage unlockRetriesMessage = QDBusMessage::createMethodCall("org.freedesktop.ModemManager1", d->modem->uni(), "org.freedesktop.DBus.Properties", "Get");
-    unlockRetriesMessage.setArguments({"org.freedesktop.ModemManager1.Modem", "UnlockRetries"});
-    QDBusMessage unlockRetriesReply = QDBusConnection::systemBus().call(unlockRetriesMessage);
-    QDBusArgument unlockRetriesArg = unlockRetriesReply.arguments().first().value<QDBusVariant>().variant().value<QDBusArgument>();
-    unlockRetriesArg >> retries;
+    //Show what we have now; the retry count will be updated once the refresh comes back
+    ModemManager::UnlockRetriesMap retries = ModemCache::instance()->unlockRetries(d->modem);
+    ModemCache::instance()->refreshUnlockRetries(d->modem);
 
     ui->currentPinPageOperatorName->setText(Common::operatorNameForModem(d->modem));
     ui->pinRetryCount->setText(tr("You have %n remaining tries", nullptr, retries.value(MM_MODEM_LOCK_SIM_PIN)));
     ui->stackedWidget->setCurrentWidget(ui->currentPinPage);
 }
 
+void SimSettingsPopover::updateRetryCount() {
+    ModemManager::UnlockRetriesMap retries = ModemCache::instance()->unlockRetries(d->modem);
+    ui->pinRetryCount->setText(tr("You have %n remaining tries", nullptr, retries.value(MM_MODEM_LOCK_SIM_PIN)));
+}
+
 void SimSettingsPopover::on_changeSimPinTitleLabel_backButtonClicked() {
     ui->stackedWidget->setCurrentWidget(ui->startPage);
 }
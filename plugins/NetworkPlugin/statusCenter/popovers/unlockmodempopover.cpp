@@ -21,6 +21,7 @@
 #include "ui_unlockmodempopover.h"
 
 #include "common.h"
+#include "modemcache.h"
 #include <QDBusPendingCallWatcher>
 #include <terrorflash.h>
 
@@ -37,6 +38,10 @@ UnlockModemPopover::UnlockModemPopover(ModemManager::ModemDevice::Ptr modem, QWi
     d->modem = modem;
     updatePage();
 
+    connect(ModemCache::instance(), &ModemCache::modemChanged, this, [ = ](QString uni) {
+        if (uni == d->modem->uni()) updateLabels();
+    });
+
     ui->simPinTitleLabel->setBackButtonShown(true);
     ui->simPukTitleLabel->setBackButtonShown(true);
     ui->spinner->setFixedSize(SC_DPI_T(QSize(32, 32), QSize));
@@ -54,27 +59,9 @@ UnlockModemPopover::~UnlockModemPopover() {
 }
 
 void UnlockModemPopover::updatePage() {
-    MMModemLock unlockRequired = d->modem->modemInterface()->unlockRequired();
-    ModemManager::UnlockRetriesMap retries;
+    MMModemLock unlockRequired = ModemCache::instance()->unlockRequired(d->modem);
 
-    QDBusMessage unlockRetriesMessage = QDBusMessage::createMethodCall("org.freedesktop.ModemManager1", d->modem->uni(), "org.freedesktop.DBus.Properties", "Get");
-    unlockRetriesMessage.setArguments({"org.freedesktop.ModemManager1.Modem", "UnlockRetries"});
-    QDBusMessage unlockRetriesReply = QDBusConnection::systemBus().call(unlockRetriesMessage);
-    QDBusArgument unlockRetriesArg = unlockRetriesReply.arguments().first().value<QDBusVariant>().variant().value<QDBusArgument>();
-    unlockRetriesArg >> retries;
-
-    if (retries.value(MM_MODEM_LOCK_SIM_PIN) == 1) {
-        ui->pinRetryCount->setText(tr("If you enter the incorrect PIN again, your SIM card will be PUK locked, and you'll need to contact your carrier."));
-    } else {
-        ui->pinRetryCount->setText(tr("You have %n remaining tries", nullptr, retries.value(MM_MODEM_LOCK_SIM_PIN)));
-    }
-    if (retries.value(MM_MODEM_LOCK_SIM_PUK) == 1) {
-        ui->pukRetryCount->setText(tr("This is your final chance to get the PUK right before you'll need to obtain a new SIM card from your carrier."));
-    } else {
-        ui->pukRetryCount->setText(tr("You have %n remaining tries", nullptr, retries.value(MM_MODEM_LOCK_SIM_PUK)));
-    }
-    ui->simPinOperatorName->setText(Common::operatorNameForModem(d->modem));
-    ui->pukDescription->setText(tr("Contact your carrier to obtain the <b>SIM PUK</b>, and enter it below to unlock %1.").arg(QLocale().quoteString(Common::operatorNameForModem(d->modem))));
+    updateLabels();
     ui->simPinBox->clear();
     ui->simPukBox->clear();
 
@@ -94,6 +81,23 @@ void UnlockModemPopover::updatePage() {
     }
 }
 
+void UnlockModemPopover::updateLabels() {
+    ModemManager::UnlockRetriesMap retries = ModemCache::instance()->unlockRetries(d->modem);
+
+    if (retries.value(MM_MODEM_LOCK_SIM_PIN) == 1) {
+        ui->pinRetryCount->setText(tr("If you enter the incorrect PIN again, your SIM card will be PUK locked, and you'll need to contact your carrier."));
+    } else {
+        ui->pinRetryCount->setText(tr("You have %n remaining tries", nullptr, retries.value(MM_MODEM_LOCK_SIM_PIN)));
+    }
+    if (retries.value(MM_MODEM_LOCK_SIM_PUK) == 1) {
+        ui->pukRetryCount->setText(tr("This is your final chance to get the PUK right before you'll need to obtain a new SIM card from your carrier."));
+    } else {
+        ui->pukRetryCount->setText(tr("You have %n remaining tries", nullptr, retries.value(MM_MODEM_LOCK_SIM_PUK)));
+    }
+    ui->simPinOperatorName->setText(Common::operatorNameForModem(d->modem));
+    ui->pukDescription->setText(tr("Contact your carrier to obtain the <b>SIM PUK</b>, and enter it below to unlock %1.").arg(QLocale().quoteString(Common::operatorNameForModem(d->modem))));
+}
+
 void UnlockModemPopover::on_simPinAcceptButton_clicked() {
     bool ok;
     ui->simPinBox->text().toInt(&ok);
@@ -110,6 +114,7 @@ void UnlockModemPopover::on_simPinAcceptButton_clicked() {
     ui->stackedWidget->setCurrentWidget(ui->loadingPage);
     QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->modem->sim()->sendPin(ui->simPinBox->text()));
     connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        ModemCache::instance()->refreshUnlockRetries(d->modem);
         QTimer::singleShot(200, this, &UnlockModemPopover::updatePage);
         watcher->deleteLater();
     });
@@ -151,6 +156,7 @@ void UnlockModemPopover::on_simPukAcceptButton_clicked() {
     ui->stackedWidget->setCurrentWidget(ui->loadingPage);
     QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->modem->sim()->sendPuk(ui->simPukBox->text(), ui->simPukNewSimPin->text()));
     connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        ModemCache::instance()->refreshUnlockRetries(d->modem);
         QTimer::singleShot(200, this, &UnlockModemPopover::updatePage);
         watcher->deleteLater();
     });
@@ -52,6 +52,7 @@ class UnlockModemPopover : public QWidget {
         UnlockModemPopoverPrivate* d;
 
         void updatePage();
+        void updateLabels();
 };
 
 #endif // UNLOCKMODEMPOPOVER_H
@@ -21,6 +21,7 @@
 #include "ui_hudwidget.h"
 
 #include <statemanager.h>
+#include <animationclock.h>
 #include <hudmanager.h>
 #include <QIcon>
 #include <QGraphicsOpacityEffect>
@@ -150,14 +151,17 @@ void HudWidget::animateShow() {
     anim->setEasingCurve(QEasingCurve::OutCubic);
     anim->setDuration(250);
     connect(anim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        this->setFixedHeight(value.toInt());
-        emit shouldShowChanged();
+        StateManager::animationClock()->scheduleFrameWork(this, "height", [ = ] {
+            this->setFixedHeight(value.toInt());
+            emit shouldShowChanged();
+        });
     });
     connect(anim, &tVariantAnimation::finished, this, [ = ] {
         anim->deleteLater();
         d->hideTimer->start();
         d->state = 2;
     });
+    StateManager::animationClock()->registerAnimation(anim);
     anim->start();
 }
 
@@ -173,8 +177,10 @@ void HudWidget::animateHide() {
     anim->setEasingCurve(QEasingCurve::OutCubic);
     anim->setDuration(250);
     connect(anim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        this->setFixedHeight(value.toInt());
-        emit shouldShowChanged();
+        StateManager::animationClock()->scheduleFrameWork(this, "height", [ = ] {
+            this->setFixedHeight(value.toInt());
+            emit shouldShowChanged();
+        });
     });
     connect(anim, &tVariantAnimation::finished, this, [ = ] {
         anim->deleteLater();
@@ -183,5 +189,6 @@ void HudWidget::animateHide() {
         d->shouldShow = false;
         emit shouldShowChanged();
     });
+    StateManager::animationClock()->registerAnimation(anim);
     anim->start();
 }
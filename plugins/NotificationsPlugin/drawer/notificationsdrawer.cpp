@@ -102,6 +102,9 @@ void NotificationsDrawer::updateGeometry() {
 }
 
 void NotificationsDrawer::showNotification(NotificationPtr notification) {
+    //Notifications carried over from before a restart have already been shown once
+    if (d->tracker->isRestored(notification->id())) return;
+
     switch (StateManager::quietModeManager()->currentMode()) {
         case QuietModeManager::CriticalOnly:
             if (notification->urgency() != Notification::Critical) return;
@@ -21,8 +21,10 @@
 #include "ui_notificationsdrawerwidget.h"
 
 #include <tvariantanimation.h>
+#include <statemanager.h>
+#include <animationclock.h>
 #include <QIcon>
-#include <QGraphicsOpacityEffect>
+#include <QPainter>
 #include <QPushButton>
 #include "notificationtracker.h"
 #include "notification.h"
@@ -35,7 +37,9 @@ struct NotificationsDrawerWidgetPrivate {
 
     QList<QPushButton*> actions;
 
-    QGraphicsOpacityEffect* effect;
+    //Painted in place of the card while it fades out
+    QPixmap dismissSnapshot;
+    qreal dismissOpacity = 1;
     bool shouldTimeoutRun = false;
 };
 
@@ -97,24 +101,26 @@ NotificationsDrawerWidget::NotificationsDrawerWidget(NotificationPtr notificatio
     d->actionsWidgetHeight->setDuration(250);
     d->actionsWidgetHeight->setEasingCurve(QEasingCurve::OutCubic);
     connect(d->actionsWidgetHeight, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        ui->actionsWidget->setFixedHeight(value.toInt());
-        ui->mainFrame->setFixedHeight(ui->mainFrame->sizeHint().height());
-        this->updateGeometry();
+        StateManager::animationClock()->scheduleFrameWork(this, "actionsHeight", [ = ] {
+            ui->actionsWidget->setFixedHeight(value.toInt());
+            ui->mainFrame->setFixedHeight(ui->mainFrame->sizeHint().height());
+            this->updateGeometry();
+        });
     });
     connect(d->actionsWidgetHeight, &tVariantAnimation::finished, this, [ = ] {
-        ui->mainFrame->setFixedHeight(ui->mainFrame->sizeHint().height());
-        this->updateGeometry();
+        StateManager::animationClock()->scheduleFrameWork(this, "actionsHeight", [ = ] {
+            ui->actionsWidget->setFixedHeight(d->actionsWidgetHeight->endValue().toInt());
+            ui->mainFrame->setFixedHeight(ui->mainFrame->sizeHint().height());
+            this->updateGeometry();
+        });
     });
+    StateManager::animationClock()->registerAnimation(d->actionsWidgetHeight);
 
     ui->buttonBox->setParent(ui->mainFrame);
     ui->buttonBox->move(ui->mainFrame->width() - ui->buttonBox->width(), 0);
     ui->buttonBox->setVisible(false);
 
     ui->mainFrame->installEventFilter(this);
-
-    d->effect = new QGraphicsOpacityEffect(this);
-    d->effect->setEnabled(false);
-    this->setGraphicsEffect(d->effect);
 }
 
 NotificationsDrawerWidget::~NotificationsDrawerWidget() {
@@ -131,7 +137,9 @@ void NotificationsDrawerWidget::show() {
     anim->setEasingCurve(QEasingCurve::OutCubic);
     anim->setDuration(250);
     connect(anim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        ui->mainFrame->move(value.toInt(), SC_DPI(9));
+        StateManager::animationClock()->scheduleFrameWork(this, "slide", [ = ] {
+            ui->mainFrame->move(value.toInt(), SC_DPI(9));
+        });
     });
     connect(anim, &tVariantAnimation::finished, this, [ = ] {
         d->shouldTimeoutRun = true;
@@ -139,6 +147,7 @@ void NotificationsDrawerWidget::show() {
             d->timeout->start();
         }
     });
+    StateManager::animationClock()->registerAnimation(anim);
     anim->start();
 }
 
@@ -151,7 +160,10 @@ void NotificationsDrawerWidget::animateDismiss() {
     opacityAnim->setEasingCurve(QEasingCurve::OutCubic);
     opacityAnim->setDuration(250);
     connect(opacityAnim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        d->effect->setOpacity(value.toDouble());
+        d->dismissOpacity = value.toDouble();
+        StateManager::animationClock()->scheduleFrameWork(this, "repaint", [ = ] {
+            this->update();
+        });
     });
     connect(opacityAnim, &tVariantAnimation::finished, this, [ = ] {
         opacityAnim->deleteLater();
@@ -162,15 +174,22 @@ void NotificationsDrawerWidget::animateDismiss() {
         anim->setEasingCurve(QEasingCurve::OutCubic);
         anim->setDuration(250);
         connect(anim, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-            this->setFixedHeight(value.toInt());
+            StateManager::animationClock()->scheduleFrameWork(this, "height", [ = ] {
+                this->setFixedHeight(value.toInt());
+            });
         });
         connect(anim, &tVariantAnimation::finished, this, [ = ] {
             anim->deleteLater();
             emit dismiss();
         });
+        StateManager::animationClock()->registerAnimation(anim);
         anim->start();
     });
-    d->effect->setEnabled(true);
+
+    //Fade a snapshot of the card rather than rendering it through an opacity effect every frame
+    d->dismissSnapshot = this->grab();
+    ui->mainFrame->setVisible(false);
+    StateManager::animationClock()->registerAnimation(opacityAnim);
     opacityAnim->start();
 }
 
@@ -180,6 +199,14 @@ QSize NotificationsDrawerWidget::sizeHint() const {
     return sizeHint;
 }
 
+void NotificationsDrawerWidget::paintEvent(QPaintEvent* event) {
+    if (d->dismissSnapshot.isNull()) return;
+
+    QPainter painter(this);
+    painter.setOpacity(d->dismissOpacity);
+    painter.drawPixmap(0, 0, d->dismissSnapshot);
+}
+
 void NotificationsDrawerWidget::resizeEvent(QResizeEvent* event) {
     ui->mainFrame->setFixedWidth(this->width() - SC_DPI(18));
     ui->mainFrame->setFixedHeight(ui->mainFrame->sizeHint().height());
@@ -55,6 +55,7 @@ class NotificationsDrawerWidget : public QWidget {
         Ui::NotificationsDrawerWidget* ui;
         NotificationsDrawerWidgetPrivate* d;
 
+        void paintEvent(QPaintEvent* event);
         void resizeEvent(QResizeEvent* event);
         bool eventFilter(QObject* watched, QEvent* event);
 
@@ -21,16 +21,23 @@
 
 #include <QPointer>
 #include <QMap>
+#include <QSet>
 #include <QTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <server/sessionserver.h>
 #include "notification.h"
 
 struct NotificationTrackerPrivate {
     quint32 lastNotification = 1;
     QMap<quint32, NotificationPtr> notifications;
+    QSet<quint32> restoredNotifications;
 };
 
 NotificationTracker::NotificationTracker(QObject* parent) : QObject(parent) {
     d = new NotificationTrackerPrivate();
+
+    if (SessionServer::instance()->isHotRestart()) restore();
 }
 
 NotificationTracker::~NotificationTracker() {
@@ -42,11 +49,17 @@ NotificationPtr NotificationTracker::createNotification() {
     NotificationPtr n(new Notification(notificationId));
     connect(n.data(), &Notification::dismissed, this, [ = ] {
         d->notifications.remove(notificationId);
+        d->restoredNotifications.remove(notificationId);
+        checkpoint();
     });
+    connect(n.data(), &Notification::summaryChanged, this, &NotificationTracker::checkpoint);
+    connect(n.data(), &Notification::bodyChanged, this, &NotificationTracker::checkpoint);
+    connect(n.data(), &Notification::applicationChanged, this, &NotificationTracker::checkpoint);
     d->notifications.insert(notificationId, n);
     d->lastNotification++;
 
     QTimer::singleShot(0, this, std::bind(&NotificationTracker::newNotification, this, n));
+    QTimer::singleShot(0, this, &NotificationTracker::checkpoint);
 
     return n;
 }
@@ -55,3 +68,50 @@ NotificationPtr NotificationTracker::get(quint32 id) {
     if (id == 0) return nullptr;
     return d->notifications.value(id);
 }
+
+bool NotificationTracker::isRestored(quint32 id) {
+    return d->restoredNotifications.contains(id);
+}
+
+void NotificationTracker::checkpoint() {
+    //Actions can't be invoked once the sender has lost track of us, so only the content is kept
+    QJsonArray notifications;
+    for (NotificationPtr notification : d->notifications) {
+        if (!notification) continue;
+
+        QJsonObject n;
+        n.insert("summary", notification->summary());
+        n.insert("body", notification->body());
+        n.insert("urgency", notification->urgency());
+        if (notification->application()) {
+            n.insert("desktopEntry", notification->application()->desktopEntry());
+            n.insert("appName", notification->application()->getProperty("Name").toString());
+            n.insert("appIcon", notification->application()->getProperty("Icon").toString());
+        }
+        notifications.append(n);
+    }
+    SessionServer::instance()->setRestorableState("notifications", notifications);
+}
+
+void NotificationTracker::restore() {
+    for (QJsonValue value : SessionServer::instance()->restoredState("notifications").toArray()) {
+        QJsonObject n = value.toObject();
+
+        NotificationPtr notification = createNotification();
+        d->restoredNotifications.insert(notification->id());
+        notification->setSummary(n.value("summary").toString());
+        notification->setBody(n.value("body").toString());
+        notification->setUrgency(static_cast<Notification::Urgency>(n.value("urgency").toInt(Notification::Normal)));
+        notification->setTimeout(0);
+
+        QString desktopEntry = n.value("desktopEntry").toString();
+        if (!desktopEntry.isEmpty() && Application::allApplications().contains(desktopEntry)) {
+            notification->setApplication(ApplicationPointer(new Application(desktopEntry)));
+        } else {
+            notification->setApplication(ApplicationPointer(new Application({
+                {"Icon", n.value("appIcon").toString("generic-app")},
+                {"Name", n.value("appName").toString()}
+            })));
+        }
+    }
+}
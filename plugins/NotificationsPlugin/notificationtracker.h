@@ -35,6 +35,7 @@ class NotificationTracker : public QObject {
 
         NotificationPtr createNotification();
         NotificationPtr get(quint32 id);
+        bool isRestored(quint32 id);
 
     signals:
         void newNotification(NotificationPtr notification);
@@ -44,6 +45,9 @@ class NotificationTracker : public QObject {
 
     private:
         NotificationTrackerPrivate* d;
+
+        void checkpoint();
+        void restore();
 };
 
 #endif // NOTIFICATIONTRACKER_H
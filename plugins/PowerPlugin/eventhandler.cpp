@@ -29,8 +29,10 @@
 #include <QTimer>
 
 #include <statemanager.h>
+#include <animationclock.h>
 #include <powermanager.h>
 #include <hudmanager.h>
+#include <windowstatemanager.h>
 #include <keygrab.h>
 
 #include <Wm/desktopwm.h>
@@ -39,6 +41,7 @@
 #include <UPower/desktopupowerdevice.h>
 
 #include <tsettings.h>
+#include <settingbinding.h>
 #include <tvariantanimation.h>
 
 struct EventHandlerPrivate {
@@ -49,6 +52,10 @@ struct EventHandlerPrivate {
     DesktopUPower* upower;
 
     tSettings settings;
+    SettingBinding<int>* screenOffTimeout;
+    SettingBinding<QString>* screenOffTimeoutUnit;
+    SettingBinding<int>* suspendTimeout;
+    SettingBinding<QString>* suspendTimeoutUnit;
     quint64 oldIdleTimer = 0;
 
     bool screenOffActionPerformed = false;
@@ -79,6 +86,12 @@ EventHandler::EventHandler(QObject* parent) : QObject(parent) {
     d = new EventHandlerPrivate();
     d->upower = new DesktopUPower();
 
+    //The idle timeouts are checked every second so keep them cached
+    d->screenOffTimeout = new SettingBinding<int>(&d->settings, "Power/timeouts.screenoff.value", this);
+    d->screenOffTimeoutUnit = new SettingBinding<QString>(&d->settings, "Power/timeouts.screenoff.unit", this);
+    d->suspendTimeout = new SettingBinding<int>(&d->settings, "Power/timeouts.suspend.value", this);
+    d->suspendTimeoutUnit = new SettingBinding<QString>(&d->settings, "Power/timeouts.suspend.unit", this);
+
     QDBusMessage message = QDBusMessage::createMethodCall("org.freedesktop.login1", "/org/freedesktop/login1", "org.freedesktop.login1.Manager", "Inhibit");
     message.setArguments(QList<QVariant>() << "handle-power-key:idle" << "theDesk" << "theDesk handles hardware power keys and idling" << "block");
     QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(message));
@@ -116,12 +129,15 @@ EventHandler::EventHandler(QObject* parent) : QObject(parent) {
     d->suspendNotificationAnimation->setForceAnimation(true);
     d->suspendNotificationAnimation->setDuration(15000);
     connect(d->suspendNotificationAnimation, &tVariantAnimation::valueChanged, this, [ = ](QVariant value) {
-        StateManager::instance()->hudManager()->showHud({
-            {"icon", "system-suspend"},
-            {"title", tr("Suspend")},
-            {"text", tr("%n seconds", nullptr, (15000 - d->suspendNotificationAnimation->currentTime()) / 1000 + 1)},
-            {"value", value.toDouble()},
-            {"timeout", 15000}
+        int secondsRemaining = (15000 - d->suspendNotificationAnimation->currentTime()) / 1000 + 1;
+        StateManager::animationClock()->scheduleFrameWork(this, "suspendHud", [ = ] {
+            StateManager::instance()->hudManager()->showHud({
+                {"icon", "system-suspend"},
+                {"title", tr("Suspend")},
+                {"text", tr("%n seconds", nullptr, secondsRemaining)},
+                {"value", value.toDouble()},
+                {"timeout", 15000}
+            });
         });
 
         //Immediately do an idle timer check if the idle timer has changed
@@ -129,13 +145,17 @@ EventHandler::EventHandler(QObject* parent) : QObject(parent) {
     });
     connect(d->suspendNotificationAnimation, &tVariantAnimation::stateChanged, this, [ = ](tVariantAnimation::State newState, tVariantAnimation::State oldState) {
         if (newState == tVariantAnimation::Stopped) {
-            StateManager::instance()->hudManager()->hideHud();
+            //Replace any update still waiting for the end of the frame so the HUD doesn't come back
+            StateManager::animationClock()->scheduleFrameWork(this, "suspendHud", [ = ] {
+                StateManager::instance()->hudManager()->hideHud();
+            });
         }
     });
     connect(d->suspendNotificationAnimation, &tVariantAnimation::finished, this, [ = ] {
         //Suspend now
         StateManager::powerManager()->performPowerOperation(PowerManager::Suspend);
     });
+    StateManager::animationClock()->registerAnimation(d->suspendNotificationAnimation);
 
     connect(d->upower, QOverload<DesktopUPowerDevice*>::of(&DesktopUPower::deviceAdded), this, &EventHandler::trackDevice);
     connect(d->upower, QOverload<DesktopUPowerDevice*>::of(&DesktopUPower::deviceRemoved), this, &EventHandler::removeDevice);
@@ -165,13 +185,11 @@ void EventHandler::checkIdleTimer() {
     d->oldIdleTimer = idleTimer;
 
     //Ensure that there are no full screen windows so we don't switch off the screen if someone is watching a video for instance
-    for (DesktopWmWindowPtr window : DesktopWm::openWindows()) {
-        if (window->isFullScreen()) return;
-    }
+    if (StateManager::windowStateManager()->hasFullScreenWindow()) return;
 
     if (!d->screenOffActionPerformed) {
         //See if we need to turn the screen off
-        quint64 timeout = d->settings.value("Power/timeouts.screenoff.value").toInt() * d->timeoutFactors.value(d->settings.value("Power/timeouts.screenoff.unit").toString(), 0);
+        quint64 timeout = d->screenOffTimeout->value() * d->timeoutFactors.value(d->screenOffTimeoutUnit->value(), 0);
         if (idleTimer > timeout && timeout != 0) {
             //Turn the screen off now
             StateManager::powerManager()->performPowerOperation(PowerManager::TurnOffScreen);
@@ -181,7 +199,7 @@ void EventHandler::checkIdleTimer() {
 
     if (!d->suspendActionPerformed) {
         //See if we need to suspend
-        quint64 timeout = d->settings.value("Power/timeouts.suspend.value").toInt() * d->timeoutFactors.value(d->settings.value("Power/timeouts.suspend.unit").toString(), 0);
+        quint64 timeout = d->suspendTimeout->value() * d->timeoutFactors.value(d->suspendTimeoutUnit->value(), 0);
         if (idleTimer > timeout && timeout != 0) {
             //Notify the user about the impending suspension and then suspend
             d->suspendActionPerformed = true;
@@ -16,6 +16,7 @@ SOURCES += \
     onboarding/onboardingtimezone.cpp \
     plugin.cpp \
     popovers/settimezonepopover.cpp \
+    search/timezonesearchprovider.cpp \
     settings/datetimepane.cpp \
     timezonesmodel.cpp
 
@@ -23,6 +24,7 @@ HEADERS += \
     onboarding/onboardingtimezone.h \
     plugin.h \
     popovers/settimezonepopover.h \
+    search/timezonesearchprovider.h \
     settings/datetimepane.h \
     timezonesmodel.h
 
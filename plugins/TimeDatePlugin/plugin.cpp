@@ -22,6 +22,7 @@
 #include <QDebug>
 #include <statemanager.h>
 #include <statuscentermanager.h>
+#include <gatewaymanager.h>
 #include <localemanager.h>
 #include <QApplication>
 #include <QDir>
@@ -29,6 +30,7 @@
 #include "tsettings.h"
 
 #include "settings/datetimepane.h"
+#include "search/timezonesearchprovider.h"
 
 #include "onboarding/onboardingtimezone.h"
 
@@ -36,6 +38,7 @@ struct PluginPrivate {
     int translationSet;
 
     DateTimePane* dateTimePane;
+    TimezoneSearchProvider* searchProvider;
 };
 
 Plugin::Plugin() {
@@ -58,12 +61,17 @@ void Plugin::activate() {
     d->dateTimePane = new DateTimePane();
     StateManager::statusCenterManager()->addPane(d->dateTimePane, StatusCenterManager::SystemSettings);
 
+    d->searchProvider = new TimezoneSearchProvider(d->dateTimePane);
+    StateManager::gatewayManager()->addSearchProvider(d->searchProvider);
+
     QObject::connect(StateManager::onboardingManager(), &OnboardingManager::onboardingRequired, [ = ] {
         StateManager::onboardingManager()->addOnboardingStep(new OnboardingTimeZone());
     });
 }
 
 void Plugin::deactivate() {
+    StateManager::gatewayManager()->removeSearchProvider(d->searchProvider);
+    d->searchProvider->deleteLater();
     StateManager::statusCenterManager()->removePane(d->dateTimePane);
     d->dateTimePane->deleteLater();
     StateManager::localeManager()->removeTranslationSet(d->translationSet);
@@ -0,0 +1,92 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "timezonesearchprovider.h"
+
+#include <QPointer>
+#include <QTimeZone>
+#include <QLocale>
+#include <statemanager.h>
+#include <statuscentermanager.h>
+#include <statuscenterpane.h>
+#include <idleworkqueue.h>
+
+struct TimezoneSearchProviderPrivate {
+    QPointer<StatusCenterPane> dateTimePane;
+
+    //City names paired with their time zone IDs
+    QList<QPair<QString, QByteArray>> cities;
+};
+
+TimezoneSearchProvider::TimezoneSearchProvider(StatusCenterPane* dateTimePane, QObject* parent) : SearchProvider(parent) {
+    d = new TimezoneSearchProviderPrivate();
+    d->dateTimePane = dateTimePane;
+
+    //Listing the time zones touches the whole zoneinfo database, so keep it off the main thread
+    IdleWorkQueue::compute<QList<QPair<QString, QByteArray>>>(this, [ = ] {
+        QList<QPair<QString, QByteArray>> cities;
+        for (QByteArray timezone : QTimeZone::availableTimeZoneIds()) {
+            QString id = timezone;
+            if (!id.contains("/")) continue; //Not a city
+            cities.append({id.split("/").last().replace("_", " "), timezone});
+        }
+        return cities;
+    }, [ = ](QList<QPair<QString, QByteArray>> cities) {
+        d->cities = cities;
+    });
+}
+
+TimezoneSearchProvider::~TimezoneSearchProvider() {
+    delete d;
+}
+
+QString TimezoneSearchProvider::name() {
+    return tr("World Clock");
+}
+
+void TimezoneSearchProvider::search(SearchQueryPtr query) {
+    //Short queries match too many cities
+    if (query->query().length() < 3) {
+        query->finish();
+        return;
+    }
+
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    QList<SearchResult> results;
+    for (const QPair<QString, QByteArray>& city : qAsConst(d->cities)) {
+        if (!city.first.contains(query->query(), Qt::CaseInsensitive)) continue;
+
+        QTimeZone timezone(city.second);
+        SearchResult result;
+        result.title = tr("%1 in %2").arg(QLocale().toString(now.toTimeZone(timezone).time(), QLocale::ShortFormat), city.first);
+        result.description = timezone.displayName(now, QTimeZone::LongName);
+        result.icon = QIcon::fromTheme("clock");
+
+        QPointer<StatusCenterPane> dateTimePane = d->dateTimePane;
+        result.activate = [ = ] {
+            if (dateTimePane) StateManager::statusCenterManager()->showPane(dateTimePane);
+        };
+        results.append(result);
+
+        if (results.count() == 5) break;
+    }
+
+    query->addResults(results);
+    query->finish();
+}
@@ -20,24 +20,29 @@
 #include "user.h"
 
 #include <unistd.h>
-#include <QDBusInterface>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusArgument>
 
 struct UserPrivate {
-    QDBusInterface* interface;
+    QDBusObjectPath path;
 
-    qulonglong uid;
+    qulonglong uid = 0;
     QString realName;
     QString userName;
     QString displayName;
-    User::UserType userType;
+    User::UserType userType = User::StandardUser;
 
-    bool locked;
+    bool locked = false;
+
+    bool updatePending = false;
+    bool updateQueued = false;
 };
 
 User::User(QDBusObjectPath path, QObject *parent) : QObject(parent)
 {
     d = new UserPrivate();
-    d->interface = new QDBusInterface("org.freedesktop.Accounts", path.path(), "org.freedesktop.Accounts.User", QDBusConnection::systemBus());
+    d->path = path;
 
     QDBusConnection::systemBus().connect("org.freedesktop.Accounts", path.path(), "org.freedesktop.Accounts.User", "Changed", this, SLOT(changed()));
 
@@ -51,7 +56,7 @@ User::~User()
 
 QDBusObjectPath User::path()
 {
-    return QDBusObjectPath(d->interface->path());
+    return d->path;
 }
 
 bool User::isCurrentUser()
@@ -91,7 +96,7 @@ tPromise<void>* User::setPassword(QString password, QString hint)
         }
         QString crypted = QString::fromLatin1(crypt(password.toUtf8(), salt.constData()));
 
-        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->interface->asyncCall("SetPassword", crypted, hint));
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(this->callUserMethod("SetPassword", {crypted, hint}));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
             if (watcher->isError()) {
                 rej(watcher->error().message());
@@ -105,7 +110,7 @@ tPromise<void>* User::setPassword(QString password, QString hint)
 tPromise<void>* User::setPasswordMode(User::PasswordMode mode)
 {
     return new tPromise<void>([=](std::function<void()> res, std::function<void(QString)> rej) {
-        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->interface->asyncCall("SetPasswordMode", static_cast<int>(mode)));
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(this->callUserMethod("SetPasswordMode", {static_cast<int>(mode)}));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
             if (watcher->isError()) {
                 rej(watcher->error().message());
@@ -119,7 +124,7 @@ tPromise<void>* User::setPasswordMode(User::PasswordMode mode)
 tPromise<void>*User::setUserType(User::UserType type)
 {
     return new tPromise<void>([=](std::function<void()> res, std::function<void(QString)> rej) {
-        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->interface->asyncCall("SetAccountType", static_cast<int>(type)));
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(this->callUserMethod("SetAccountType", {static_cast<int>(type)}));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
             if (watcher->isError()) {
                 rej(watcher->error().message());
@@ -133,7 +138,7 @@ tPromise<void>*User::setUserType(User::UserType type)
 tPromise<void>*User::setRealName(QString realName)
 {
     return new tPromise<void>([=](std::function<void()> res, std::function<void(QString)> rej) {
-        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->interface->asyncCall("SetRealName", realName));
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(this->callUserMethod("SetRealName", {realName}));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
             if (watcher->isError()) {
                 rej(watcher->error().message());
@@ -147,7 +152,7 @@ tPromise<void>*User::setRealName(QString realName)
 tPromise<void>*User::setLocked(bool locked)
 {
     return new tPromise<void>([=](std::function<void()> res, std::function<void(QString)> rej) {
-        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->interface->asyncCall("SetLocked", locked));
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(this->callUserMethod("SetLocked", {locked}));
         connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
             if (watcher->isError()) {
                 rej(watcher->error().message());
@@ -181,18 +186,53 @@ tPromise<void>*User::deleteUser(bool removeFiles)
 void User::changed()
 {
     this->update();
-    emit dataUpdated();
 }
 
 void User::update()
 {
-    d->uid = d->interface->property("Uid").toULongLong();
-    d->realName = d->interface->property("RealName").toString();
-    d->userName = d->interface->property("UserName").toString();
-    d->locked = d->interface->property("Locked").toBool();
-    d->userType = static_cast<UserType>(d->interface->property("AccountType").toInt());
+    //Only keep one GetAll in flight; if something changes in the meantime, fetch again once it returns
+    if (d->updatePending) {
+        d->updateQueued = true;
+        return;
+    }
+    d->updatePending = true;
+
+    QDBusMessage message = QDBusMessage::createMethodCall("org.freedesktop.Accounts", d->path.path(), "org.freedesktop.DBus.Properties", "GetAll");
+    message.setArguments({"org.freedesktop.Accounts.User"});
+
+    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
+        watcher->deleteLater();
+        d->updatePending = false;
+
+        if (!watcher->isError()) {
+            QDBusArgument arg = watcher->reply().arguments().first().value<QDBusArgument>();
+            QVariantMap properties;
+            arg >> properties;
+
+            d->uid = properties.value("Uid").toULongLong();
+            d->realName = properties.value("RealName").toString();
+            d->userName = properties.value("UserName").toString();
+            d->locked = properties.value("Locked").toBool();
+            d->userType = static_cast<UserType>(properties.value("AccountType").toInt());
+
+            QString displayName = d->realName;
+            if (displayName.isEmpty()) displayName = d->userName;
+            d->displayName = displayName;
+
+            emit dataUpdated();
+        }
 
-    QString displayName = d->realName;
-    if (displayName.isEmpty()) displayName = d->userName;
-    d->displayName = displayName;
+        if (d->updateQueued) {
+            d->updateQueued = false;
+            this->update();
+        }
+    });
+}
+
+QDBusPendingCall User::callUserMethod(QString method, QVariantList args)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall("org.freedesktop.Accounts", d->path.path(), "org.freedesktop.Accounts.User", method);
+    message.setArguments(args);
+    return QDBusConnection::systemBus().asyncCall(message);
 }
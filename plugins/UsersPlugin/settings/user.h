@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QDBusObjectPath>
+#include <QDBusPendingCall>
 #include <QSharedPointer>
 #include <tpromise.h>
 
@@ -70,6 +71,7 @@ class User : public QObject
         UserPrivate* d;
 
         void update();
+        QDBusPendingCall callUserMethod(QString method, QVariantList args);
 };
 typedef QSharedPointer<User> UserPtr;
 Q_DECLARE_METATYPE(UserPtr);
@@ -30,6 +30,8 @@
 
 struct UsersModelPrivate {
     QList<UserPtr> users;
+    QHash<QString, UserPtr> usersByPath;
+    QHash<User*, int> rows;
 };
 
 UsersModel::UsersModel(QObject *parent)
@@ -43,15 +45,29 @@ UsersModel::UsersModel(QObject *parent)
     QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.Accounts", "/org/freedesktop/Accounts", "org.freedesktop.Accounts", "ListCachedUsers");
     QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg));
     connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
+        watcher->deleteLater();
+        if (watcher->isError()) return;
+
         QDBusArgument arg = watcher->reply().arguments().first().value<QDBusArgument>();
-        QList<QDBusObjectPath> users;
-        arg >> users;
-        for (QDBusObjectPath user : users) {
-            this->userAdded(user);
+        QList<QDBusObjectPath> paths;
+        arg >> paths;
+
+        QList<UserPtr> newUsers;
+        for (QDBusObjectPath path : paths) {
+            if (d->usersByPath.contains(path.path())) continue;
+            newUsers.append(this->createUser(path));
         }
+        if (newUsers.isEmpty()) return;
 
-        watcher->deleteLater();
-        emit dataChanged(index(0), index(rowCount()));
+        //Insert every user in one go; their properties will arrive asynchronously
+        int first = d->users.count();
+        beginInsertRows(QModelIndex(), first, first + newUsers.count() - 1);
+        for (UserPtr u : newUsers) {
+            d->rows.insert(u.data(), d->users.count());
+            d->usersByPath.insert(u->path().path(), u);
+            d->users.append(u);
+        }
+        endInsertRows();
     });
 }
 
@@ -84,22 +100,42 @@ QVariant UsersModel::data(const QModelIndex &index, int role) const
 
 void UsersModel::userAdded(QDBusObjectPath path)
 {
-    UserPtr u(new User(path));
-    connect(u.data(), &User::dataUpdated, this, [=] {
-        int i = d->users.indexOf(u);
-        emit dataChanged(index(i), index(i));
-    });
+    if (d->usersByPath.contains(path.path())) return;
+
+    UserPtr u = this->createUser(path);
+    int row = d->users.count();
+    beginInsertRows(QModelIndex(), row, row);
+    d->rows.insert(u.data(), row);
+    d->usersByPath.insert(path.path(), u);
     d->users.append(u);
-    emit dataChanged(index(0), index(rowCount()));
+    endInsertRows();
 }
 
 void UsersModel::userRemoved(QDBusObjectPath path)
 {
-    for (UserPtr u : d->users) {
-        if (u->path() == path) {
-            d->users.removeOne(u);
-            emit dataChanged(index(0), index(rowCount()));
-            return;
-        }
+    UserPtr u = d->usersByPath.value(path.path());
+    if (!u) return;
+
+    int row = d->rows.value(u.data());
+    beginRemoveRows(QModelIndex(), row, row);
+    d->users.removeAt(row);
+    d->usersByPath.remove(path.path());
+    d->rows.remove(u.data());
+    for (int i = row; i < d->users.count(); i++) {
+        d->rows.insert(d->users.at(i).data(), i);
     }
+    endRemoveRows();
+}
+
+UserPtr UsersModel::createUser(QDBusObjectPath path)
+{
+    UserPtr u(new User(path));
+    User* user = u.data();
+    connect(user, &User::dataUpdated, this, [=] {
+        if (!d->rows.contains(user)) return;
+
+        QModelIndex idx = index(d->rows.value(user));
+        emit dataChanged(idx, idx);
+    });
+    return u;
 }
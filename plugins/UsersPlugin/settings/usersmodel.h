@@ -22,6 +22,7 @@
 
 #include <QAbstractListModel>
 #include <QDBusObjectPath>
+#include "user.h"
 
 struct UsersModelPrivate;
 class UsersModel : public QAbstractListModel
@@ -44,6 +45,8 @@ class UsersModel : public QAbstractListModel
     private:
         UsersModelPrivate* d;
 
+        UserPtr createUser(QDBusObjectPath path);
+
 };
 
 #endif // USERSMODEL_H
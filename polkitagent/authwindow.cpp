@@ -51,6 +51,11 @@ AuthWindow::AuthWindow(QWidget* parent) :
     connect(escShortcut, &QShortcut::activated, this, [ = ] {
         ui->titleLabel->backButtonClicked();
     });
+
+    //Do the expensive parts of showing the prompt up front so it can appear straight away
+    this->ensurePolished();
+    this->adjustSize();
+    d->overlay.winId();
 }
 
 AuthWindow::~AuthWindow() {
@@ -96,6 +101,7 @@ void AuthWindow::showAuthWindow() {
                 d->session->setProperty("cancelled", true);
                 d->session->cancel();
                 d->session->deleteLater();
+                d->session = nullptr;
             }
 
             if (d->callback) {
@@ -104,7 +110,14 @@ void AuthWindow::showAuthWindow() {
             }
 
             d->overlay.close();
+
+            //Take the window back from the popover so it can be used for the next request
+            this->hide();
+            this->setParent(nullptr);
             popover->deleteLater();
+
+            this->reset();
+            emit finished();
         });
         popover->show(&d->overlay);
     });
@@ -149,6 +162,7 @@ void AuthWindow::initiateSession(PolkitQt1::Identity identity) {
                 d->session = nullptr;
 
                 d->callback->setCompleted();
+                d->callback = nullptr;
                 emit dismiss();
             } else {
                 initiateSession(identity);
@@ -172,6 +186,21 @@ void AuthWindow::initiateSession(PolkitQt1::Identity identity) {
     d->session->initiate();
 }
 
+void AuthWindow::reset() {
+    if (d->session) {
+        d->session->setProperty("cancelled", true);
+        d->session->deleteLater();
+        d->session = nullptr;
+    }
+    d->callback = nullptr;
+    d->cookie.clear();
+    d->identities.clear();
+
+    ui->passwordBox->setText("");
+    ui->responseBox->setText("");
+    ui->stackedWidget->setCurrentWidget(ui->loadingPage, false);
+}
+
 void AuthWindow::on_okPasswordButton_clicked() {
     ui->stackedWidget->setCurrentWidget(ui->loadingPage);
     d->session->setResponse(ui->passwordBox->text());
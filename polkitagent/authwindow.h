@@ -46,6 +46,7 @@ class AuthWindow : public QWidget {
 
     signals:
         void dismiss();
+        void finished();
 
     private slots:
         void on_okPasswordButton_clicked();
@@ -61,6 +62,7 @@ class AuthWindow : public QWidget {
         AuthWindowPrivate* d;
 
         void initiateSession(PolkitQt1::Identity identity);
+        void reset();
 };
 
 #endif // AUTHWINDOW_H
@@ -20,10 +20,15 @@
 #include "common.h"
 
 #include <Wm/desktopwm.h>
+#include <QHash>
 
 QString Common::stringForIdentity(PolkitQt1::Identity identity) {
     if (identity.toUnixUserIdentity().isValid()) {
-        return DesktopWm::displayName(identity.toUnixUserIdentity().uid());
+        //Looking up the display name hits the user database, and the same few users come up in every prompt
+        static QHash<uint, QString> displayNames;
+        uint uid = identity.toUnixUserIdentity().uid();
+        if (!displayNames.contains(uid)) displayNames.insert(uid, DesktopWm::displayName(uid));
+        return displayNames.value(uid);
     } else {
         return identity.toString();
     }
@@ -25,10 +25,14 @@
 
 struct PolkitInterfacePrivate {
     QPointer<AuthWindow> authWin;
+    AuthWindow* spareAuthWin = nullptr;
 };
 
 PolkitInterface::PolkitInterface() : PolkitQt1::Agent::Listener() {
     d = new PolkitInterfacePrivate();
+
+    //Keep a prompt ready so it doesn't need to be built when an authentication request comes in
+    d->spareAuthWin = createAuthWindow();
 }
 
 PolkitInterface::~PolkitInterface() {
@@ -36,7 +40,13 @@ PolkitInterface::~PolkitInterface() {
 }
 
 void PolkitInterface::initiateAuthentication(const QString& actionId, const QString& message, const QString& iconName, const PolkitQt1::Details& details, const QString& cookie, const PolkitQt1::Identity::List& identities, PolkitQt1::Agent::AsyncResult* result) {
-    d->authWin = new AuthWindow();
+    if (d->spareAuthWin) {
+        d->authWin = d->spareAuthWin;
+        d->spareAuthWin = nullptr;
+    } else {
+        d->authWin = createAuthWindow();
+    }
+
     d->authWin->setMessage(message);
     d->authWin->setIdentities(identities);
     d->authWin->setCookie(cookie);
@@ -53,3 +63,16 @@ void PolkitInterface::cancelAuthentication() {
         d->authWin->cancel();
     }
 }
+
+AuthWindow* PolkitInterface::createAuthWindow() {
+    AuthWindow* authWin = new AuthWindow();
+    connect(authWin, &AuthWindow::finished, this, [ = ] {
+        //Recycle the prompt for the next request
+        if (d->spareAuthWin) {
+            authWin->deleteLater();
+        } else {
+            d->spareAuthWin = authWin;
+        }
+    });
+    return authWin;
+}
@@ -25,6 +25,7 @@
 #include <PolkitQt1/Identity>
 #include <PolkitQt1/Subject>
 
+class AuthWindow;
 struct PolkitInterfacePrivate;
 class PolkitInterface : public PolkitQt1::Agent::Listener {
         Q_OBJECT
@@ -38,6 +39,8 @@ class PolkitInterface : public PolkitQt1::Agent::Listener {
     private:
         PolkitInterfacePrivate* d;
 
+        AuthWindow* createAuthWindow();
+
         // Listener interface
     public slots:
         void initiateAuthentication(const QString& actionId, const QString& message, const QString& iconName, const PolkitQt1::Details& details, const QString& cookie, const PolkitQt1::Identity::List& identities, PolkitQt1::Agent::AsyncResult* result);
@@ -41,14 +41,8 @@ int main(int argc, char* argv[]) {
     tSettings settings;
     ScreenDaemon::instance()->setDpi(settings.value("Display/dpi").toInt());
 
-    //Check for initialisation script
-    if (settings.value("Session/UseInitializationScript").toBool()) {
-        QProcess process;
-        process.start(settings.value("Session/InitializationScript").toString(), QStringList());
-        process.waitForFinished();
-    }
-
-    SplashController::instance()->startDE();
+    //Bring up the initialisation script, window manager, shell, polkit agent and autostart as they become ready
+    SplashController::instance()->startSession();
 
     return a.exec();
 }
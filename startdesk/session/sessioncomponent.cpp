@@ -0,0 +1,151 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "sessioncomponent.h"
+
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusServiceWatcher>
+#include <QDebug>
+#include <QLoggingCategory>
+
+#ifdef HAVE_X11
+    #include <QX11Info>
+    #include <X11/Xlib.h>
+#endif
+
+Q_LOGGING_CATEGORY(sessionStartupLog, "thedesk.session.startup", QtInfoMsg)
+
+struct SessionComponentPrivate {
+    QString name;
+    std::function<void()> start;
+    QStringList dependencies;
+
+    SessionComponent::ReadyCondition condition = SessionComponent::ReadyWhenStarted;
+    QString conditionArgument;
+    int timeout = 10000;
+
+    bool started = false;
+    bool ready = false;
+    QElapsedTimer startTimer;
+    QTimer* pollTimer = nullptr;
+};
+
+SessionComponent::SessionComponent(QString name, std::function<void()> start, QObject* parent) : QObject(parent) {
+    d = new SessionComponentPrivate();
+    d->name = name;
+    d->start = start;
+}
+
+SessionComponent::~SessionComponent() {
+    delete d;
+}
+
+QString SessionComponent::name() {
+    return d->name;
+}
+
+void SessionComponent::setDependencies(QStringList dependencies) {
+    d->dependencies = dependencies;
+}
+
+QStringList SessionComponent::dependencies() {
+    return d->dependencies;
+}
+
+void SessionComponent::setReadyCondition(ReadyCondition condition, QString argument) {
+    d->condition = condition;
+    d->conditionArgument = argument;
+}
+
+void SessionComponent::setTimeout(int timeout) {
+    d->timeout = timeout;
+}
+
+bool SessionComponent::isStarted() {
+    return d->started;
+}
+
+bool SessionComponent::isReady() {
+    return d->ready;
+}
+
+void SessionComponent::start() {
+    if (d->started) return;
+    d->started = true;
+    d->startTimer.start();
+
+    //Don't let a component that never becomes ready hold up the rest of the session
+    QTimer::singleShot(d->timeout, this, [ = ] {
+        if (d->ready) return;
+        qWarning() << "Session component" << d->name << "did not become ready in time";
+        markReady();
+    });
+
+    switch (d->condition) {
+        case ReadyWhenDBusNameOwned: {
+            QDBusServiceWatcher* watcher = new QDBusServiceWatcher(d->conditionArgument, QDBusConnection::sessionBus(), QDBusServiceWatcher::WatchForRegistration, this);
+            connect(watcher, &QDBusServiceWatcher::serviceRegistered, this, &SessionComponent::markReady);
+            break;
+        }
+        case ReadyWhenSelectionOwned:
+#ifdef HAVE_X11
+            //X doesn't announce new selection owners to clients that don't own the selection, so poll for it
+            d->pollTimer = new QTimer(this);
+            d->pollTimer->setInterval(50);
+            connect(d->pollTimer, &QTimer::timeout, this, &SessionComponent::checkSelectionOwner);
+            d->pollTimer->start();
+#endif
+            break;
+        default:
+            break;
+    }
+
+    d->start();
+
+    if (d->condition == ReadyWhenStarted) {
+        markReady();
+    } else if (d->condition == ReadyWhenDBusNameOwned && QDBusConnection::sessionBus().interface()->isServiceRegistered(d->conditionArgument)) {
+        markReady();
+    } else if (d->condition == ReadyWhenSelectionOwned) {
+#ifdef HAVE_X11
+        checkSelectionOwner();
+#else
+        markReady();
+#endif
+    }
+}
+
+void SessionComponent::markReady() {
+    if (d->ready) return;
+    d->ready = true;
+    if (d->pollTimer) d->pollTimer->stop();
+
+    qCDebug(sessionStartupLog) << "Session component" << d->name << "ready after" << d->startTimer.elapsed() << "ms";
+    emit ready();
+}
+
+void SessionComponent::checkSelectionOwner() {
+#ifdef HAVE_X11
+    Atom selection = XInternAtom(QX11Info::display(), d->conditionArgument.toUtf8().constData(), False);
+    if (XGetSelectionOwner(QX11Info::display(), selection) != None) markReady();
+#endif
+}
@@ -0,0 +1,64 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef SESSIONCOMPONENT_H
+#define SESSIONCOMPONENT_H
+
+#include <QObject>
+#include <functional>
+
+struct SessionComponentPrivate;
+class SessionComponent : public QObject {
+        Q_OBJECT
+    public:
+        enum ReadyCondition {
+            ReadyWhenStarted,
+            ReadyWhenDBusNameOwned,
+            ReadyWhenSelectionOwned,
+            ReadyWhenMarked
+        };
+
+        explicit SessionComponent(QString name, std::function<void()> start, QObject* parent = nullptr);
+        ~SessionComponent();
+
+        QString name();
+
+        void setDependencies(QStringList dependencies);
+        QStringList dependencies();
+
+        //Argument is the D-Bus name or the X selection to wait for
+        void setReadyCondition(ReadyCondition condition, QString argument = "");
+        void setTimeout(int timeout);
+
+        bool isStarted();
+        bool isReady();
+
+        void start();
+        void markReady();
+
+    signals:
+        void ready();
+
+    private:
+        SessionComponentPrivate* d;
+
+        void checkSelectionOwner();
+};
+
+#endif // SESSIONCOMPONENT_H
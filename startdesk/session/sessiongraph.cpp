@@ -0,0 +1,76 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "sessiongraph.h"
+
+#include <QMap>
+#include <QDebug>
+#include "sessioncomponent.h"
+
+struct SessionGraphPrivate {
+    QMap<QString, SessionComponent*> components;
+    bool started = false;
+};
+
+SessionGraph::SessionGraph(QObject* parent) : QObject(parent) {
+    d = new SessionGraphPrivate();
+}
+
+SessionGraph::~SessionGraph() {
+    delete d;
+}
+
+void SessionGraph::addComponent(SessionComponent* component) {
+    component->setParent(this);
+    d->components.insert(component->name(), component);
+    connect(component, &SessionComponent::ready, this, &SessionGraph::startReadyComponents);
+}
+
+SessionComponent* SessionGraph::component(QString name) {
+    return d->components.value(name);
+}
+
+void SessionGraph::start() {
+    d->started = true;
+    startReadyComponents();
+}
+
+void SessionGraph::startReadyComponents() {
+    if (!d->started) return;
+
+    bool allReady = true;
+    for (SessionComponent* component : d->components.values()) {
+        if (!component->isReady()) allReady = false;
+        if (component->isStarted()) continue;
+
+        //Start everything whose dependencies are ready, so independent components come up together
+        bool dependenciesReady = true;
+        for (QString dependency : component->dependencies()) {
+            SessionComponent* dependencyComponent = d->components.value(dependency);
+            if (dependencyComponent && !dependencyComponent->isReady()) dependenciesReady = false;
+        }
+
+        if (dependenciesReady) component->start();
+    }
+
+    if (allReady) {
+        d->started = false;
+        emit finished();
+    }
+}
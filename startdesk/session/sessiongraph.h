@@ -0,0 +1,47 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef SESSIONGRAPH_H
+#define SESSIONGRAPH_H
+
+#include <QObject>
+
+class SessionComponent;
+struct SessionGraphPrivate;
+class SessionGraph : public QObject {
+        Q_OBJECT
+    public:
+        explicit SessionGraph(QObject* parent = nullptr);
+        ~SessionGraph();
+
+        void addComponent(SessionComponent* component);
+        SessionComponent* component(QString name);
+
+        void start();
+
+    signals:
+        void finished();
+
+    private:
+        SessionGraphPrivate* d;
+
+        void startReadyComponents();
+};
+
+#endif // SESSIONGRAPH_H
@@ -0,0 +1,217 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#include "autostartscheduler.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTimer>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <climits>
+#include <tpromise.h>
+#include <Applications/application.h>
+#include <the-libs_global.h>
+
+//How long a launch counts against the concurrency limit, giving the app time to load
+#define AUTOSTART_SETTLE_TIME 750
+
+struct AutostartEntry {
+    ApplicationPointer app;
+    QString desktopEntry;
+    int phase;
+    int priority;
+    qint64 releaseTime;
+};
+
+struct AutostartSchedulerPrivate {
+    QElapsedTimer clock;
+    QList<AutostartEntry> pending;
+    int inFlight = 0;
+    bool loaded = false;
+
+    QTimer* releaseTimer;
+
+    //Phases from the GNOME session specification, in the order they are started
+    const static QStringList phases;
+};
+
+const QStringList AutostartSchedulerPrivate::phases = {
+    "EarlyInitialization",
+    "PreDisplayServer",
+    "DisplayServer",
+    "Initialization",
+    "WindowManager",
+    "Panel",
+    "Desktop",
+    "Applications"
+};
+
+AutostartScheduler::AutostartScheduler(QObject* parent) : QObject(parent) {
+    d = new AutostartSchedulerPrivate();
+
+    d->releaseTimer = new QTimer(this);
+    d->releaseTimer->setSingleShot(true);
+    connect(d->releaseTimer, &QTimer::timeout, this, &AutostartScheduler::launchNext);
+}
+
+AutostartScheduler::~AutostartScheduler() {
+    delete d;
+}
+
+void AutostartScheduler::start() {
+    d->clock.start();
+
+    QStringList searchPaths = {
+        qEnvironmentVariable("XDG_CONFIG_HOME", QDir::homePath() + "/.config") + "/autostart",
+        qEnvironmentVariable("XDG_CONFIG_DIRS", "/etc/xdg") + "/autostart"
+    };
+
+    //Parsing entries and resolving TryExec touches the disk a lot, so keep it off the GUI thread
+    (new tPromise<QList<AutostartEntry>>([ = ](QString & error) {
+        QList<AutostartEntry> entries;
+        for (QString desktopEntry : Application::allApplications(searchPaths)) {
+            ApplicationPointer app(new Application(desktopEntry, searchPaths));
+            if (app->getProperty("Hidden", "false").toString() == "true") continue; //Ignore this autostart entry
+            if (!app->getStringList("OnlyShowIn", {"thedesk"}).contains("thedesk")) continue;
+            if (app->getStringList("NotShowIn").contains("thedesk")) continue;
+
+            if (app->hasProperty("TryExec")) {
+                QString tryExecPath = app->getProperty("TryExec").toString();
+                if (tryExecPath.startsWith("/")) {
+                    //TryExec is an absolute path
+                    QFile testFile(tryExecPath);
+                    if (!testFile.exists() | testFile.permissions() & ~QFile::ExeUser) continue;
+                } else {
+                    //TryExec should be searched for in the PATH
+                    if (theLibsGlobal::searchInPath(tryExecPath).isEmpty()) continue;
+                }
+            }
+
+            AutostartEntry entry;
+            entry.app = app;
+            entry.desktopEntry = desktopEntry;
+
+            int phase = AutostartSchedulerPrivate::phases.indexOf(app->getProperty("X-GNOME-Autostart-Phase", "Applications").toString());
+            if (phase == -1) phase = AutostartSchedulerPrivate::phases.indexOf("Applications");
+            if (app->hasProperty("X-KDE-autostart-phase")) {
+                //KDE phases 0, 1 and 2 map to the panel, desktop and applications phases
+                const QStringList kdePhases = {"Panel", "Desktop", "Applications"};
+                phase = AutostartSchedulerPrivate::phases.indexOf(kdePhases.at(qBound(0, app->getProperty("X-KDE-autostart-phase").toInt(), 2)));
+            }
+            entry.phase = phase;
+            entry.priority = app->getProperty("X-theDesk-Autostart-Priority", 0).toInt();
+            entry.releaseTime = app->getProperty("X-GNOME-Autostart-Delay", 0).toInt() * 1000;
+            entries.append(entry);
+        }
+
+        std::stable_sort(entries.begin(), entries.end(), [](const AutostartEntry & first, const AutostartEntry & second) {
+            if (first.phase != second.phase) return first.phase < second.phase;
+            return first.priority > second.priority;
+        });
+        return entries;
+    }))->then([ = ](QList<AutostartEntry> entries) {
+        for (AutostartEntry& entry : entries) {
+            entry.releaseTime += d->clock.elapsed();
+        }
+        d->pending = entries;
+        d->loaded = true;
+        launchNext();
+    });
+}
+
+void AutostartScheduler::launchNext() {
+    if (!d->loaded) return;
+
+    int limit = concurrencyLimit();
+    qint64 now = d->clock.elapsed();
+    qint64 nextRelease = -1;
+
+    //Later phases wait until every undelayed entry in earlier phases has been launched
+    int blockingPhase = INT_MAX;
+    for (const AutostartEntry& entry : d->pending) {
+        if (entry.releaseTime <= now) {
+            blockingPhase = entry.phase;
+            break;
+        }
+    }
+
+    for (int i = 0; i < d->pending.count() && d->inFlight < limit;) {
+        AutostartEntry entry = d->pending.at(i);
+        if (entry.releaseTime > now) {
+            if (nextRelease == -1 || entry.releaseTime < nextRelease) nextRelease = entry.releaseTime;
+            i++;
+            continue;
+        }
+        if (entry.phase > blockingPhase) break;
+
+        d->pending.removeAt(i);
+
+        QElapsedTimer launchTimer;
+        launchTimer.start();
+        entry.app->launch();
+        qint64 launchTime = launchTimer.elapsed();
+
+        emit entryLaunched({
+            {"entry", entry.desktopEntry},
+            {"name", entry.app->getProperty("Name", entry.desktopEntry).toString()},
+            {"phase", AutostartSchedulerPrivate::phases.at(entry.phase)},
+            {"priority", entry.priority},
+            {"startedAt", now},
+            {"waited", now - entry.releaseTime},
+            {"launchTime", launchTime}
+        });
+
+        d->inFlight++;
+        QTimer::singleShot(AUTOSTART_SETTLE_TIME, this, [ = ] {
+            d->inFlight--;
+            launchNext();
+        });
+    }
+
+    if (d->pending.isEmpty()) {
+        if (d->inFlight == 0) {
+            d->loaded = false;
+            emit finished();
+        }
+    } else if (nextRelease != -1 && d->inFlight == 0) {
+        d->releaseTimer->start(qMax<qint64>(0, nextRelease - now));
+    }
+}
+
+int AutostartScheduler::concurrencyLimit() {
+    int cpus = QThread::idealThreadCount();
+
+    //If the disk is already busy, launching more apps in parallel only slows everything down
+    QFile pressure("/proc/pressure/io");
+    if (pressure.open(QFile::ReadOnly)) {
+        QRegularExpressionMatch match = QRegularExpression("some avg10=([0-9.]+)").match(pressure.readAll());
+        if (match.hasMatch() && match.captured(1).toDouble() > 10) return 1;
+    }
+
+    QFile loadAverage("/proc/loadavg");
+    if (loadAverage.open(QFile::ReadOnly)) {
+        double load = QString(loadAverage.readAll()).split(" ").first().toDouble();
+        if (load > cpus) return 1;
+        if (load > cpus / 2.0) return 2;
+    }
+
+    return qBound(1, cpus / 2, 4);
+}
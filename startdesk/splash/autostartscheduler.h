@@ -0,0 +1,46 @@
+/****************************************
+ *
+ *   INSERT-PROJECT-NAME-HERE - INSERT-GENERIC-NAME-HERE
+ *   Copyright (C) 2020 Victor Tran
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * *************************************/
+#ifndef AUTOSTARTSCHEDULER_H
+#define AUTOSTARTSCHEDULER_H
+
+#include <QObject>
+#include <QJsonObject>
+
+struct AutostartSchedulerPrivate;
+class AutostartScheduler : public QObject {
+        Q_OBJECT
+    public:
+        explicit AutostartScheduler(QObject* parent = nullptr);
+        ~AutostartScheduler();
+
+        void start();
+
+    signals:
+        void entryLaunched(QJsonObject report);
+        void finished();
+
+    private:
+        AutostartSchedulerPrivate* d;
+
+        void launchNext();
+        int concurrencyLimit();
+};
+
+#endif // AUTOSTARTSCHEDULER_H
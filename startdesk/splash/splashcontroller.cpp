@@ -30,8 +30,13 @@
 #include <QJsonObject>
 #include <QPointer>
 #include <QDir>
-#include <Applications/application.h>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
 #include <the-libs_global.h>
+#include <tsettings.h>
+#include "autostartscheduler.h"
+#include "session/sessiongraph.h"
+#include "session/sessioncomponent.h"
 #include "splashwindow.h"
 
 struct SplashControllerPrivate {
@@ -47,11 +52,18 @@ struct SplashControllerPrivate {
 
     QByteArray buffer;
 
+    SessionGraph* session = nullptr;
     bool autostartDone = false;
+
+    QJsonObject checkpoint;
+    bool hotRestarting = false;
+    QElapsedTimer lastHotRestart;
 };
 
 SplashControllerPrivate* SplashController::d = new SplashControllerPrivate();
 
+Q_LOGGING_CATEGORY(hotRestartLog, "thedesk.session.hotrestart", QtInfoMsg)
+
 SplashController::SplashController(QObject* parent) : QObject(parent) {
     this->initSession();
 }
@@ -59,42 +71,51 @@ SplashController::SplashController(QObject* parent) : QObject(parent) {
 void SplashController::socketDataAvailable() {
     d->buffer.append(d->socket->readAll());
 
-    int bracket = 0;
-    for (int i = 0; i < d->buffer.count(); i++) {
-        if (d->buffer.at(i) == '{') {
-            bracket++;
-        } else if (d->buffer.at(i) == '}') {
-            bracket--;
-        } else if (bracket == 0) {
-            //Error
-            d->buffer = d->buffer.mid(i + 1);
-            i = -1;
-        }
+    //Messages are framed one per line
+    int newline;
+    while ((newline = d->buffer.indexOf('\n')) != -1) {
+        QByteArray data = d->buffer.left(newline);
+        d->buffer.remove(0, newline + 1);
+
+        QJsonDocument doc = QJsonDocument::fromJson(data);
+        QJsonObject obj = doc.object();
+        if (obj.contains("type")) {
+            QString type = obj.value("type").toString();
+            if (type == "hideSplash") {
+                emit hideSplashes();
+            } else if (type == "showSplash") {
+                emit starting();
+            } else if (type == "autoStart") {
+                if (d->hotRestarting) {
+                    qCDebug(hotRestartLog) << "theDesk recovered from crash in" << d->lastHotRestart.elapsed() << "ms";
+
+                    //The restart is complete; anything after this is a fresh start
+                    d->hotRestarting = false;
+                }
 
-        if (bracket == 0) {
-            QByteArray data = d->buffer.left(i + 1);
-            d->buffer = d->buffer.mid(i + 1);
-            i = -1;
-
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            QJsonObject obj = doc.object();
-            if (obj.contains("type")) {
-                QString type = obj.value("type").toString();
-                if (type == "hideSplash") {
-                    emit hideSplashes();
-                } else if (type == "showSplash") {
-                    emit starting();
-                } else if (type == "autoStart") {
-                    //Run Autostart apps
+                //The shell has finished loading; autostart apps follow from the session graph
+                if (d->session) {
+                    d->session->component("thedesk")->markReady();
+                } else {
                     this->runAutostart();
-                } else if (type == "question") {
-                    emit question(obj.value("title").toString(), obj.value("question").toString());
                 }
+            } else if (type == "question") {
+                emit question(obj.value("title").toString(), obj.value("question").toString());
+            } else if (type == "checkpoint") {
+                d->checkpoint = obj.value("state").toObject();
             }
         }
     }
 }
 
+void SplashController::sendMessage(QJsonObject message) {
+    if (!d->socket) return;
+
+    //Compact JSON never contains a raw newline, so it can be used to separate messages
+    d->socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact).append('\n'));
+    d->socket->flush();
+}
+
 SplashController::~SplashController() {
 
 }
@@ -117,65 +138,117 @@ void SplashController::initSession() {
     d->server = new QLocalServer(this);
     connect(d->server, &QLocalServer::newConnection, this, [ = ] {
         d->socket = d->server->nextPendingConnection();
+        d->buffer.clear();
         connect(d->socket, &QLocalSocket::readyRead, this, &SplashController::socketDataAvailable);
         connect(d->socket, &QLocalSocket::disconnected, d->socket, &QLocalSocket::deleteLater);
         d->server->close();
+
+        //Hand the last checkpoint back if the shell is coming back from a crash
+        sendMessage(QJsonObject({
+            {"type", "sessionState"},
+            {"hotRestart", d->hotRestarting},
+            {"state", d->hotRestarting ? d->checkpoint : QJsonObject()}
+        }));
+    });
+}
+
+void SplashController::startSession() {
+    if (d->session) return;
+    tSettings settings;
+
+    d->session = new SessionGraph(this);
+
+    bool useInitializationScript = settings.value("Session/UseInitializationScript").toBool();
+    QString initializationScript = settings.value("Session/InitializationScript").toString();
+    SessionComponent* init = new SessionComponent("init", [ = ] {
+        if (!useInitializationScript) return;
+
+        QProcess* process = new QProcess(this);
+        connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [ = ] {
+            d->session->component("init")->markReady();
+            process->deleteLater();
+        });
+        connect(process, &QProcess::errorOccurred, this, [ = ](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) d->session->component("init")->markReady();
+        });
+        process->start(initializationScript, QStringList());
+    });
+    if (useInitializationScript) {
+        init->setReadyCondition(SessionComponent::ReadyWhenMarked);
+        init->setTimeout(30000);
+    }
+    d->session->addComponent(init);
+
+    //The window manager is ready once it owns the WM selection for the screen
+    SessionComponent* wm = new SessionComponent("wm", [ = ] {
+        this->startWM();
+    });
+    wm->setDependencies({"init"});
+    wm->setReadyCondition(SessionComponent::ReadyWhenSelectionOwned, "WM_S0");
+    wm->setTimeout(5000);
+    d->session->addComponent(wm);
+
+    //The shell lays out its windows without needing the window manager, so start it alongside
+    SessionComponent* thedesk = new SessionComponent("thedesk", [ = ] {
+        this->startDE();
+    });
+    thedesk->setDependencies({"init"});
+    thedesk->setReadyCondition(SessionComponent::ReadyWhenMarked);
+    thedesk->setTimeout(30000);
+    d->session->addComponent(thedesk);
+
+    SessionComponent* polkit = new SessionComponent("polkit", [ = ] {
+        QString pkPath = QStringLiteral(SYSTEM_LIBRARY_DIRECTORY).append("/td-polkitagent");
+        if (QFile::exists(pkPath)) {
+            QProcess::startDetached(pkPath, QStringList());
+        }
+    });
+    polkit->setDependencies({"init"});
+    d->session->addComponent(polkit);
+
+    SessionComponent* autostart = new SessionComponent("autostart", [ = ] {
+        this->runAutostart();
     });
+    autostart->setDependencies({"wm", "thedesk"});
+    d->session->addComponent(autostart);
 
-    //Start the window manager
-    this->startWM();
+    d->session->start();
 }
 
 void SplashController::runAutostart() {
     if (d->autostartDone) return;
 
-    //Autostart the Polkit agent
-    QString pkPath = QStringLiteral(SYSTEM_LIBRARY_DIRECTORY).append("/td-polkitagent");
-    if (QFile::exists(pkPath)) {
-        QProcess::startDetached(pkPath, QStringList());
-    }
-
-    QStringList searchPaths = {
-        qEnvironmentVariable("XDG_CONFIG_HOME", QDir::homePath() + "/.config") + "/autostart",
-        qEnvironmentVariable("XDG_CONFIG_DIRS", "/etc/xdg") + "/autostart"
-    };
-
-    for (QString desktopEntry : Application::allApplications(searchPaths)) {
-        ApplicationPointer app(new Application(desktopEntry, searchPaths));
-        if (app->getProperty("Hidden", "false").toString() == "true") continue; //Ignore this autostart entry
-        if (!app->getStringList("OnlyShowIn", {"thedesk"}).contains("thedesk")) continue;
-        if (app->getStringList("NotShowIn").contains("thedesk")) continue;
-
-        if (app->hasProperty("TryExec")) {
-            QString tryExecPath = app->getProperty("TryExec").toString();
-            if (tryExecPath.startsWith("/")) {
-                //TryExec is an absolute path
-                QFile testFile(tryExecPath);
-                if (!testFile.exists() | testFile.permissions() & ~QFile::ExeUser) continue;
-            } else {
-                //TryExec should be searched for in the PATH
-                if (theLibsGlobal::searchInPath(tryExecPath).isEmpty()) continue;
-            }
-        }
+    //Launch the autostart entries in phases without flooding the system while the shell finishes loading
+    AutostartScheduler* scheduler = new AutostartScheduler(this);
+    connect(scheduler, &AutostartScheduler::entryLaunched, this, [ = ](QJsonObject report) {
+        if (!d->socket) return;
 
-        //Autostart this app
-        app->launch();
-    }
+        //Let the shell know how long each entry took
+        report.insert("type", "autostartReport");
+        sendMessage(report);
+    });
+    connect(scheduler, &AutostartScheduler::finished, scheduler, &AutostartScheduler::deleteLater);
+    scheduler->start();
 
     d->autostartDone = true;
 }
 
 void SplashController::startWM() {
     if (!d->wm) {
+        tSettings settings;
+        QStringList command = QProcess::splitCommand(settings.value("Session/WindowManager").toString());
+        if (command.isEmpty()) return;
+
         d->wm = new QProcess(this);
-        d->wm->start("kwin_x11", {"--replace"}); //TODO: make this a configurable setting
+        d->wm->start(command.takeFirst(), command);
     }
 }
 
 void SplashController::startDE() {
     if (d->process) return;
 
-    emit starting();
+    //A hot restart brings the bar straight back without covering the screen with the splash
+    if (!d->hotRestarting) emit starting();
     d->server->listen(d->serverPath);
 
     QString thedeskPath = qEnvironmentVariable("THEDESK_PATH", "/usr/bin/thedesk");
@@ -189,37 +262,49 @@ void SplashController::startDE() {
 
     connect(d->process, &QProcess::errorOccurred, this, [ = ](QProcess::ProcessError error) {
         if (error == QProcess::FailedToStart) {
+            d->hotRestarting = false;
             emit startFail();
-        } else if (error == QProcess::Crashed) {
-            emit crash();
         }
     });
     connect(d->process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [ = ](int exitCode, QProcess::ExitStatus status) {
-        if (status == QProcess::NormalExit) {
-            if (exitCode == 0) {
-                this->logout();
-            } else {
-                emit crash();
-            }
-        }
-
         d->process->deleteLater();
         d->process = nullptr;
 
         d->server->close();
         if (d->socket) d->socket->close();
+
+        this->processExited(status == QProcess::CrashExit || exitCode != 0);
     });
 }
 
+void SplashController::processExited(bool crashed) {
+    if (!crashed) {
+        this->logout();
+        return;
+    }
+
+    //Restart straight away with the last checkpoint, unless we're crashing over and over again
+    if (!d->lastHotRestart.isValid() || d->lastHotRestart.hasExpired(60000)) {
+        qCDebug(hotRestartLog) << "theDesk crashed; performing hot restart";
+        d->lastHotRestart.start();
+        d->hotRestarting = true;
+        this->startDE();
+        return;
+    }
+
+    //Don't restore state that might have caused the crash when the user restarts manually
+    d->hotRestarting = false;
+    emit crash();
+}
+
 void SplashController::logout() {
     if (d->wm) d->wm->kill();
     QApplication::exit();
 }
 
 void SplashController::respond(bool answer) {
-    d->socket->write(QJsonDocument(QJsonObject({
+    sendMessage(QJsonObject({
         {"type", "questionResponse"},
         {"response", answer}
-    })).toJson());
-    d->socket->flush();
+    }));
 }
@@ -21,6 +21,7 @@
 #define SPLASHCONTROLLER_H
 
 #include <QObject>
+#include <QJsonObject>
 
 struct SplashControllerPrivate;
 class SplashController : public QObject {
@@ -31,6 +32,7 @@ class SplashController : public QObject {
         static SplashController* instance();
 
         void initSession();
+        void startSession();
         void runAutostart();
         void startWM();
         void startDE();
@@ -51,6 +53,8 @@ class SplashController : public QObject {
         static SplashControllerPrivate* d;
 
         void socketDataAvailable();
+        void sendMessage(QJsonObject message);
+        void processExited(bool crashed);
 };
 
 #endif // SPLASHCONTROLLER_H
@@ -1,9 +1,19 @@
-QT       += core gui thelib network tdesktopenvironment
+QT       += core gui thelib network tdesktopenvironment dbus
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++11
 
+unix {
+    CONFIG += link_pkgconfig
+
+    packagesExist(x11) {
+        PKGCONFIG += x11
+        DEFINES += HAVE_X11
+        QT += x11extras
+    }
+}
+
 # Include the-libs build tools
 include(/usr/share/the-libs/pri/gentranslations.pri)
 
@@ -21,12 +31,18 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
     crash/crashwidget.cpp \
     main.cpp \
+    session/sessioncomponent.cpp \
+    session/sessiongraph.cpp \
+    splash/autostartscheduler.cpp \
     splash/splashcontroller.cpp \
     splash/splashwidget.cpp \
     splashwindow.cpp
 
 HEADERS += \
     crash/crashwidget.h \
+    session/sessioncomponent.h \
+    session/sessiongraph.h \
+    splash/autostartscheduler.h \
     splash/splashcontroller.h \
     splash/splashwidget.h \
     splashwindow.h